@@ -0,0 +1,133 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "arena.hpp"
+#include "std_tuple.hpp"
+#include "tracked_record.hpp"
+#include "uses_allocator.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+struct leading { // uses the allocator after std::allocator_arg
+    using allocator_type = arena_allocator<char>;
+    leading(std::allocator_arg_t, allocator_type a, int x) : arena(a.arena), x(x) { }
+    monotonic_arena* arena;
+    int x;
+};
+
+struct trailing { // uses the allocator as its last argument
+    using allocator_type = arena_allocator<char>;
+    trailing(int x, allocator_type a) : arena(a.arena), x(x) { }
+    monotonic_arena* arena;
+    int x;
+};
+
+struct Person {
+    arena_string name;
+    int age;
+    arena_vector<int> scores;
+};
+
+bool in(void* p, char const* buffer, std::size_t size) {
+    return buffer <= static_cast<char*>(p) && static_cast<char*>(p) < buffer + size;
+}
+
+int main() {
+    // monotonic_arena
+    {
+        alignas(16) char buffer[64];
+        monotonic_arena arena{buffer, sizeof buffer};
+
+        void* a = arena.allocate(3, 1);
+        void* b = arena.allocate(8, 8);
+        assert(in(a, buffer, sizeof buffer));
+        assert(in(b, buffer, sizeof buffer));
+        assert(reinterpret_cast<std::uintptr_t>(b) % 8 == 0);
+        assert(arena.upstream_allocations() == 0);
+
+        // runs out of the initial buffer
+        void* c = arena.allocate(100, 16);
+        assert(!in(c, buffer, sizeof buffer));
+        assert(reinterpret_cast<std::uintptr_t>(c) % 16 == 0);
+        assert(arena.upstream_allocations() == 1);
+
+        // the initial buffer is used again after a release
+        arena.release();
+        void* d = arena.allocate(8, 8);
+        assert(in(d, buffer, sizeof buffer));
+    }
+
+    // arena_allocator
+    {
+        monotonic_arena arena;
+        arena_vector<int> v(arena);
+        for (int i = 0; i < 100; ++i)
+            v.push_back(i);
+        assert(v[99] == 99);
+
+        arena_string s("a string which is too long for the small buffer", arena);
+        assert(s.get_allocator() == arena_allocator<char>(arena));
+
+        monotonic_arena other;
+        assert(arena_allocator<int>(arena) != arena_allocator<char>(other));
+    }
+
+    // make_using_allocator
+    {
+        monotonic_arena arena;
+        arena_allocator<char> a(arena);
+
+        assert(make_using_allocator<int>(a, 3) == 3);
+        assert(make_using_allocator<leading>(a, 3).arena == &arena);
+        assert(make_using_allocator<trailing>(a, 3).arena == &arena);
+        assert(make_using_allocator<arena_string>(a, "abc").get_allocator() == a);
+    }
+
+    // allocate_tuple passes the allocator to the elements, also when nested
+    {
+        monotonic_arena arena;
+        arena_allocator<char> a(arena);
+
+        monotonic_arena other;
+        auto inner = allocate_tuple<arena_vector<int>, int>(
+            arena_allocator<char>(other), std::size_t{3}, 2
+        );
+        assert(get<0>(inner).get_allocator() != a);
+
+        auto t = allocate_tuple<arena_string, trailing, tuple<arena_vector<int>, int>>(
+            a, "abc", 1, std::move(inner)
+        );
+        assert(get<0>(t) == "abc" && get<0>(t).get_allocator() == a);
+        assert(get<1>(t).x == 1 && get<1>(t).arena == &arena);
+        assert(get<0>(get<2>(t)).size() == 3);
+        assert(get<0>(get<2>(t)).get_allocator() == a);
+        assert(get<1>(get<2>(t)) == 2);
+    }
+
+    // make_record_using_allocator
+    {
+        monotonic_arena arena;
+        arena_allocator<char> a(arena);
+        using Name = RECORD_MEMBER(Person, name);
+        using Age = RECORD_MEMBER(Person, age);
+        using Scores = RECORD_MEMBER(Person, scores);
+        static_assert(covers_record<Person, Name, Age, Scores>::value, "");
+        static_assert(!covers_record<Person, Name, Scores>::value, "");
+
+        Person louis = make_record_using_allocator<Person, Name, Age, Scores>(
+            a, "Louis", 22, std::size_t{3}
+        );
+        assert(louis.name == "Louis" && louis.name.get_allocator() == a);
+        assert(louis.age == 22);
+        assert(louis.scores.size() == 3 && louis.scores.get_allocator() == a);
+
+        Person empty = make_record_using_allocator<Person, Name, Age, Scores>(a);
+        assert(empty.name.empty() && empty.name.get_allocator() == a);
+        assert(empty.age == 0);
+    }
+}
@@ -0,0 +1,143 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// monotonic_arena
+//////////////////////////////////////////////////////////////////////////////
+// Hands out memory from large blocks by bumping a pointer, and only gives it
+// back to the global heap when the arena is released or destroyed. This
+// suits objects whose lifetime is bounded by a scope, like the objects built
+// to serve a request: allocating them is a few instructions, and freeing
+// them is a single `release()`.
+//
+// An initial buffer, e.g. on the stack, may be provided; it is used before
+// any block is allocated. The blocks double in size each time the arena
+// runs out of memory.
+class monotonic_arena {
+    struct block { block* next; };
+
+    char* initial_buffer_;
+    std::size_t initial_size_;
+    char* current_;
+    std::size_t remaining_;
+    std::size_t block_size_;
+    std::size_t next_size_;
+    block* blocks_ = nullptr;
+    std::size_t upstream_allocations_ = 0;
+
+    void grow(std::size_t bytes) {
+        std::size_t size = next_size_ < bytes ? bytes : next_size_;
+        block* b = static_cast<block*>(::operator new(sizeof(block) + size));
+        b->next = blocks_;
+        blocks_ = b;
+        current_ = reinterpret_cast<char*>(b + 1);
+        remaining_ = size;
+        next_size_ = 2 * size;
+        ++upstream_allocations_;
+    }
+
+public:
+    explicit monotonic_arena(std::size_t block_size = 1024)
+        : initial_buffer_(nullptr), initial_size_(0),
+          current_(nullptr), remaining_(0),
+          block_size_(block_size), next_size_(block_size)
+    { }
+
+    monotonic_arena(void* buffer, std::size_t size)
+        : initial_buffer_(static_cast<char*>(buffer)), initial_size_(size),
+          current_(initial_buffer_), remaining_(size),
+          block_size_(2 * size), next_size_(block_size_)
+    { }
+
+    monotonic_arena(monotonic_arena const&) = delete;
+    monotonic_arena& operator=(monotonic_arena const&) = delete;
+
+    ~monotonic_arena() { release(); }
+
+    void* allocate(std::size_t bytes, std::size_t alignment) {
+        void* p = current_;
+        if (current_ == nullptr || !std::align(alignment, bytes, p, remaining_)) {
+            grow(bytes + alignment);
+            p = current_;
+            std::align(alignment, bytes, p, remaining_);
+        }
+        current_ = static_cast<char*>(p) + bytes;
+        remaining_ -= bytes;
+        return p;
+    }
+
+    void deallocate(void*, std::size_t) noexcept { }
+
+    // Gives all the blocks back to the global heap. The memory allocated
+    // from the arena must not be used anymore.
+    void release() noexcept {
+        while (blocks_ != nullptr) {
+            block* next = blocks_->next;
+            ::operator delete(blocks_);
+            blocks_ = next;
+        }
+        current_ = initial_buffer_;
+        remaining_ = initial_size_;
+        next_size_ = block_size_;
+    }
+
+    // Returns the number of blocks allocated from the global heap since the
+    // arena was created.
+    std::size_t upstream_allocations() const noexcept
+    { return upstream_allocations_; }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// arena_allocator
+//////////////////////////////////////////////////////////////////////////////
+// A standard allocator referring to a `monotonic_arena`. Like the allocators
+// of `std::pmr`, it is never propagated on assignment or swap, so a
+// container keeps the arena it was created with. It can be converted from
+// an arena, so an arena can be passed wherever an allocator is expected.
+template <typename T>
+struct arena_allocator {
+    using value_type = T;
+    monotonic_arena* arena;
+
+    arena_allocator(monotonic_arena& a) noexcept : arena(&a) { }
+
+    template <typename U>
+    arena_allocator(arena_allocator<U> const& other) noexcept
+        : arena(other.arena)
+    { }
+
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length{};
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    { arena->deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(arena_allocator<T> const& a, arena_allocator<U> const& b) noexcept
+{ return a.arena == b.arena; }
+
+template <typename T, typename U>
+bool operator!=(arena_allocator<T> const& a, arena_allocator<U> const& b) noexcept
+{ return a.arena != b.arena; }
+
+using arena_string = std::basic_string<char, std::char_traits<char>, arena_allocator<char>>;
+
+template <typename T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
+#endif
@@ -13,6 +13,6 @@ int main() {
     );
 
     <% 10.times do %>
-        apply([](auto ...x) { }, xs);
+        ::apply([](auto ...x) { }, xs);
     <% end %>
 }
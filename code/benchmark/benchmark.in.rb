@@ -2,37 +2,201 @@
 # Distributed under the Boost Software License, Version 1.0.
 # (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
 
-require 'benchcc'
+# Usage: benchmark.rb <environments file> <output file> <input file>
+#
+# The environments file contains Ruby code evaluating to either
+#
+#   - an Array of Hashes, in which case each environment is measured as is, or
+#   - a Hash of the form `{ from: 0, to: 5000, env: lambda { |n| {...} } }`,
+#     in which case the sizes are chosen adaptively in `from..to`. `from`
+#     defaults to 0 and `to` defaults to BOOST_HANA_BENCHMARK_MAX_SIZE.
+#
+# Adaptive sampling starts with a coarse grid and only adds points between
+# the ones where the curve bends, so flat or linear regions are cheap. It
+# stops at the first size which fails to compile or times out, after looking
+# for the limit more precisely.
+#
+# Every point is measured several times and the output contains the mean
+# and the half-width of a 95% confidence interval for each measurement; the
+# measurement itself is in measure.rb.
+#
+# The whole measurement is repeated for each compiler in
+# BOOST_HANA_BENCHMARK_COMPILERS, each standard in
+# BOOST_HANA_BENCHMARK_STANDARDS and each header mode in
+# BOOST_HANA_BENCHMARK_HEADERS, and each row of the output records the
+# `compiler`, the `standard` and the `headers` it was measured with.
+#
+# In the `parsed` header mode, the code is compiled as is. In the
+# `precompiled` mode, the headers included by the code, i.e. the backend and
+# Hana's headers, are precompiled once per compiler, standard and set of
+# headers, and the code is compiled with that precompiled header, which
+# removes the cost of parsing them from every point of the curve. Curves
+# whose code includes no header are only measured in the `parsed` mode.
+#
+# A precompiled header which the compiler does not use is a hard error, so
+# that the `precompiled` curves are never silently parsed from source. Clang
+# is given the precompiled header with -include-pch, which fails when it is
+# rejected. GCC falls back to the header itself, so it is given
+# -Werror=invalid-pch, and it must report the precompiled header with -H
+# before anything is measured.
+
+require_relative 'measure'
+require 'csv'
+require 'open3'
 require 'pathname'
+require 'tmpdir'
 
 
-CMAKE_CXX_COMPILER = Pathname.new("@CMAKE_CXX_COMPILER@").expand_path
-CMAKE_CURRENT_SOURCE_DIR = Pathname.new("@CMAKE_CURRENT_SOURCE_DIR@").expand_path
-PROJECT_SOURCE_DIR = Pathname.new("@PROJECT_SOURCE_DIR@").expand_path
+MAX_SIZE = Integer("@BOOST_HANA_BENCHMARK_MAX_SIZE@")
+HEADERS = "@BOOST_HANA_BENCHMARK_HEADERS@".split(';')
 
 environments_file = Pathname.new(ARGV[0]).expand_path
 environments = TOPLEVEL_BINDING.eval(environments_file.read)
 output_file = Pathname.new(ARGV[1]).expand_path
 input_file = Pathname.new(ARGV[2]).expand_path
-compiler = Benchcc::Compiler.guess_from_binary(CMAKE_CXX_COMPILER)
 
 
-benchmark_opts = {
-  timeout: 45,
-  relative_to: CMAKE_CURRENT_SOURCE_DIR,
-  progressbar_format: '%p%% | %B |'
-}
+INITIAL_POINTS = 10     # number of segments of the initial grid
+MAX_POINTS = 40         # maximum number of points measured per curve
+BEND_TOLERANCE = 0.05   # relative deviation from linearity worth refining
+
+# The compiler and its options are set for each configuration below.
+binary, compiler, compiler_opts, header_mode, configuration = nil, nil, nil, nil, nil
+
+# The precompiled headers are created in a temporary directory, which is
+# removed when the benchmark is done. Each one is created from a header
+# containing the `#include`s of the benchmarked code, with the same options
+# as the code. The header is one level down, so the relative includes of the
+# benchmarks are not found next to it, but through the include paths.
+PCH_DIR = Pathname.new(Dir.mktmpdir('benchmark-pch'))
+at_exit { PCH_DIR.rmtree if PCH_DIR.exist? }
+precompiled = {}
+
+# Returns the options making the compiler use a precompiled header for the
+# headers included by `code`, or nil if `code` includes no header. Aborts if
+# the headers can't be precompiled, or if the compiler rejects the result.
+precompile = lambda do |code|
+  includes = code.lines.grep(/\A\s*#\s*include\b/).join
+  return nil if includes.empty?
+  key = [binary, compiler_opts, includes]
+  return precompiled[key] if precompiled.key?(key)
+
+  stub = PCH_DIR + precompiled.size.to_s + 'headers.hpp'
+  stub.dirname.mkpath
+  stub.write(includes)
+  clang = File.basename(binary) =~ /clang/
+  pch = Pathname.new("#{stub}#{clang ? '.pch' : '.gch'}")
+  start = Time.now
+  unless system(binary, '-x', 'c++-header', *(compiler_opts - ['-fsyntax-only']),
+                stub.to_s, '-o', pch.to_s)
+    abort "#{input_file.basename} #{configuration}: the headers could not be precompiled"
+  end
+  elapsed = Time.now - start
+
+  opts = clang ? ['-include-pch', pch.to_s]
+               : ['-include', stub.to_s, '-Winvalid-pch', '-Werror=invalid-pch']
+  unless clang
+    output, status = Open3.capture2e(binary, *compiler_opts, *opts, '-H',
+                                     '-x', 'c++', File::NULL)
+    unless status.success? && output.lines.any? { |line| line.start_with?("! #{pch}") }
+      abort "#{input_file.basename} #{configuration}: the precompiled header was rejected\n#{output}"
+    end
+  end
+  $stderr.puts "#{input_file.basename} #{configuration}: headers precompiled in #{elapsed.round(3)} s"
+  precompiled[key] = opts
+end
+
+# Returns a row containing the environment and the measurements, or nil if
+# the code could not be compiled in time.
+measure = lambda do |env|
+  code = render(input_file, env)
+  opts = compiler_opts
+  opts += precompile.(code) || [] if header_mode == 'precompiled'
+  measurement = measure_code(compiler, code, opts)
+  if measurement.nil?
+    $stderr.puts "#{input_file.basename} #{configuration} #{env}: failed"
+    return nil
+  end
+
+  $stderr.puts "#{input_file.basename} #{configuration} #{env}: #{measurement[:time].round(3)} s"
+  env.merge(measurement)
+end
+
+# Measures the sizes in `from..to` needed to describe the curve of
+# `env.(n)[:x]` against the compilation time.
+adaptive = lambda do |from, to, env|
+  rows = {}
+  tried = []
+  sizes = (0..INITIAL_POINTS).map { |i| from + (to - from) * i / INITIAL_POINTS }.uniq
+
+  # Measure the initial grid until something fails, and then bisect between
+  # the last success and the first failure.
+  failed = nil
+  sizes.each do |n|
+    tried << n
+    row = measure.(env.(n))
+    if row.nil? then failed = n; break end
+    rows[n] = row
+  end
+  while failed && !rows.empty? && failed - rows.keys.max > 1 && rows.size < MAX_POINTS
+    n = (rows.keys.max + failed) / 2
+    tried << n
+    row = measure.(env.(n))
+    if row.nil? then failed = n else rows[n] = row end
+  end
+
+  # Add points on both sides of each point where the curve is not linear.
+  loop do
+    points = rows.keys.sort
+    candidates = points.each_cons(3).flat_map do |a, b, c|
+      ya, yb, yc = rows[a][:time], rows[b][:time], rows[c][:time]
+      expected = ya + (yc - ya) * (b - a) / Float(c - a)
+      deviation = (yb - expected).abs
+      next [] if deviation <= [BEND_TOLERANCE * yb.abs, 2 * rows[b][:time_ci]].max
+      [(a + b) / 2, (b + c) / 2]
+    end
+    candidates = (candidates.uniq - tried).first([MAX_POINTS - rows.size, 0].max)
+    break if candidates.empty?
+    candidates.each do |n|
+      tried << n
+      row = measure.(env.(n))
+      rows[n] = row unless row.nil?
+    end
+  end
+
+  rows.keys.sort.map { |n| rows[n] }
+end
+
+rows = COMPILERS.product(STANDARDS, HEADERS).flat_map do |compiler_binary, standard, mode|
+  binary, header_mode = compiler_binary, mode
+  compiler = Benchcc::Compiler.guess_from_binary(Pathname.new(binary))
+  compiler_opts = compiler_opts_for(standard)
+  configuration = { compiler: File.basename(binary), standard: standard, headers: header_mode }
+
+  unless %w(parsed precompiled).include?(header_mode)
+    raise ArgumentError, "unknown header mode '#{header_mode}'; expected 'parsed' or 'precompiled'"
+  end
+  sample = environments.is_a?(Hash) ? environments.fetch(:env).(environments.fetch(:from, 0))
+                                    : environments.first
+  next [] if header_mode == 'precompiled' && (sample.nil? || precompile.(render(input_file, sample)).nil?)
 
-compiler_opts = [
-  '-std=c++1y',
-  '-fsyntax-only',
-  "-I#{PROJECT_SOURCE_DIR + 'hana' + 'include'}",
-  "-I#{PROJECT_SOURCE_DIR + 'benchmark'}"
-]
+  configuration_rows = case environments
+  when Array
+    environments.map(&measure).compact
+  when Hash
+    adaptive.(environments.fetch(:from, 0), environments.fetch(:to, MAX_SIZE),
+              environments.fetch(:env))
+  else
+    raise ArgumentError, "#{environments_file}: expected an Array or a Hash of environments"
+  end
+  configuration_rows.map { |row| configuration.merge(row) }
+end
 
-data = Benchcc::benchmark(input_file, environments, **benchmark_opts) do |code|
-  compiler.compile_code(code, *compiler_opts)
-end.to_csv
+headers = rows.flat_map(&:keys).uniq
+data = CSV.generate do |csv|
+  csv << headers
+  rows.each { |row| csv << headers.map { |h| row[h] } }
+end
 
 output_file.dirname.mkpath
-output_file.write(data)
\ No newline at end of file
+output_file.write(data)
@@ -0,0 +1,36 @@
+# Copyright Louis Dionne 2014
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+# Compiles a single instance of a benchmark and fails if it takes more time
+# or memory than allowed. The measurement is the one of benchmark.rb, with
+# the first compiler and the first standard used by the benchmarks, but
+# nothing is written to disk and no plot is drawn.
+#
+# Usage: budget.rb <environment> <input file> <max seconds> <max megabytes>
+
+require_relative 'measure'
+require 'pathname'
+
+
+environment = TOPLEVEL_BINDING.eval(ARGV[0])
+input_file = Pathname.new(ARGV[1]).expand_path
+max_time = Float(ARGV[2])
+max_memusg = Float(ARGV[3])
+compiler = Benchcc::Compiler.guess_from_binary(Pathname.new(COMPILERS.first))
+compiler_opts = compiler_opts_for(STANDARDS.first)
+
+measurement = measure_code(compiler, render(input_file, environment),
+                           compiler_opts, 4 * max_time)
+abort "#{input_file}: the probe was not compiled" if measurement.nil?
+time = measurement[:time]
+memusg = measurement[:memusg] / 1024
+
+puts "#{input_file.basename} with #{environment} (#{COMPILERS.first}, -std=#{STANDARDS.first}):"
+puts "  time:   #{time.round(3)} s (budget: #{max_time} s)"
+puts "  memory: #{memusg.round(1)} MB (budget: #{max_memusg} MB)"
+
+over_budget = []
+over_budget << 'time' if time > max_time
+over_budget << 'memory' if memusg > max_memusg
+abort "over budget: #{over_budget.join(', ')}" unless over_budget.empty?
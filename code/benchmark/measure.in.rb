@@ -0,0 +1,97 @@
+# Copyright Louis Dionne 2014
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+# Measures the compilation of a benchmark. This is used both by benchmark.rb
+# to draw the curves and by budget.rb to check single points against their
+# budget, so that the budgets are checked against the same measurement as
+# the one shown on the plots.
+
+require 'benchcc'
+require 'erb'
+require 'pathname'
+require 'timeout'
+
+
+CMAKE_CURRENT_SOURCE_DIR = Pathname.new("@CMAKE_CURRENT_SOURCE_DIR@").expand_path
+PROJECT_SOURCE_DIR = Pathname.new("@PROJECT_SOURCE_DIR@").expand_path
+REPETITIONS = Integer("@BOOST_HANA_BENCHMARK_REPETITIONS@")
+COMPILERS = "@BOOST_HANA_BENCHMARK_COMPILERS@".split(';')
+STANDARDS = "@BOOST_HANA_BENCHMARK_STANDARDS@".split(';')
+
+TIMEOUT = 45            # seconds allowed for a single compilation
+
+COMMON_OPTS = [
+  '-fsyntax-only',
+  "-I#{PROJECT_SOURCE_DIR + 'hana' + 'include'}",
+  "-I#{PROJECT_SOURCE_DIR + 'benchmark'}"
+]
+
+# Returns the options used to compile the benchmarks with the given standard.
+def compiler_opts_for(standard)
+  ["-std=#{standard}"] + COMMON_OPTS
+end
+
+# Student's t quantiles for a 95% confidence interval, indexed by the
+# number of degrees of freedom minus one.
+T_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262]
+
+def summarize(samples)
+  mean = samples.inject(:+) / samples.size
+  return [mean, 0.0] if samples.size < 2
+  variance = samples.map { |x| (x - mean)**2 }.inject(:+) / (samples.size - 1)
+  t = T_95[samples.size - 2] || 1.96
+  [mean, t * Math.sqrt(variance / samples.size)]
+end
+
+# Timeout does not stop the processes spawned by Benchcc, so they are killed
+# explicitly to avoid leaving the compiler running.
+def kill_children(pid = Process.pid)
+  `pgrep -P #{pid}`.split.map(&:to_i).each do |child|
+    kill_children(child)
+    Process.kill('KILL', child) rescue nil
+  end
+end
+
+def binding_of(env)
+  b = binding
+  env.each { |name, value| b.local_variable_set(name, value) }
+  b
+end
+
+# Returns the code of the ERB template `input_file` for the environment `env`.
+def render(input_file, env)
+  ERB.new(input_file.read).result(binding_of(env))
+end
+
+# Returns the `key` field of a result of Benchcc's `compile_code`, which are
+# `:time` and `:memusg`, the same as the columns of the CSV files produced by
+# Benchcc. A missing field means the Benchcc version is not supported, so it
+# is an error rather than a failed compilation.
+def result_field(result, key)
+  result.fetch(key) do
+    raise KeyError, "Benchcc's compile_code returned no #{key.inspect} field " +
+                    "(got #{result.keys.inspect}); this version of Benchcc is not supported"
+  end
+end
+
+# Compiles `code` REPETITIONS times and returns the mean and the half-width
+# of a 95% confidence interval of the compilation time, in seconds, and of
+# the peak memory usage, in kilobytes. Returns nil if any of the
+# compilations fails or takes more than `timeout` seconds.
+def measure_code(compiler, code, opts, timeout = TIMEOUT)
+  results = REPETITIONS.times.map do
+    begin
+      Timeout.timeout(timeout) { compiler.compile_code(code, *opts) }
+    rescue Timeout::Error
+      kill_children
+      return nil
+    rescue StandardError
+      return nil
+    end
+  end
+
+  time, time_ci = summarize(results.map { |r| Float(result_field(r, :time)) })
+  memusg, memusg_ci = summarize(results.map { |r| Float(result_field(r, :memusg)) })
+  { time: time, time_ci: time_ci, memusg: memusg, memusg_ci: memusg_ci }
+end
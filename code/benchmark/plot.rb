@@ -2,10 +2,58 @@
 # Distributed under the Boost Software License, Version 1.0.
 # (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
 
-require 'benchcc'
+# Usage: plot.rb <gnuplot> <time output> <memusg output> <datasets>
+#
+# Draws one curve per dataset and per (compiler, standard, headers)
+# configuration found in it, with the confidence interval of each point as
+# an error bar.
+# `datasets` is a semicolon-separated list of CSV files produced by
+# benchmark.rb.
 
+require 'csv'
+require 'pathname'
 
-time_output, memusg_output, inputs = ARGV
-inputs = inputs.split(';')
-Benchcc::plot_time(time_output, *inputs)
-Benchcc::plot_memusg(memusg_output, *inputs)
\ No newline at end of file
+
+gnuplot, time_output, memusg_output, inputs = ARGV
+inputs = inputs.split(';').map { |input| Pathname.new(input).expand_path }
+
+# Returns a Hash associating a title to the rows of each curve.
+def curves(inputs)
+  datasets = inputs.map do |input|
+    [input.basename.to_s, CSV.read(input, headers: true, converters: :numeric)]
+  end
+  configuration = lambda { |row| [row['compiler'], row['standard'], row['headers']] }
+  configurations = datasets.flat_map { |_, table| table.map(&configuration) }.uniq
+
+  datasets.flat_map do |name, table|
+    table.group_by(&configuration).map do |(compiler, standard, headers), rows|
+      details = [compiler, "-std=#{standard}", headers && "#{headers} headers"].compact
+      title = configurations.size > 1 ? "#{name} (#{details.join(', ')})" : name
+      [title, rows.sort_by { |row| row['x'] }]
+    end
+  end
+end
+
+def plot(gnuplot, output, curves, column, ylabel, scale)
+  return if curves.empty?
+  plots = curves.map { |title, _| "'-' using 1:2:3 with yerrorlines title '#{title}'" }
+  data = curves.map do |_, rows|
+    rows.map { |row| "#{row['x']},#{row[column] * scale},#{row["#{column}_ci"] * scale}" }
+        .push('e').join("\n")
+  end
+
+  script = <<-GNUPLOT
+    set terminal png size 1200,800 noenhanced
+    set output '#{output}'
+    set datafile separator ','
+    set key left top
+    set xlabel 'Number of elements'
+    set ylabel '#{ylabel}'
+    plot #{plots.join(", \\\n         ")}
+  GNUPLOT
+  IO.popen([gnuplot], 'w') { |io| io.write(script + data.join("\n") + "\n") }
+end
+
+curves = curves(inputs)
+plot(gnuplot, time_output, curves, 'time', 'Compilation time (s)', 1)
+plot(gnuplot, memusg_output, curves, 'memusg', 'Memory usage (MB)', 1.0 / 1024)
@@ -0,0 +1,32 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+<% if technique == "hana" %>
+#include <boost/hana/integral.hpp>
+#include <boost/hana/range.hpp>
+using namespace boost::hana;
+<% else %>
+#include "../integer_range.hpp"
+<% end %>
+
+
+struct bit_xor {
+    constexpr int operator()(int x, int y) const { return x ^ y; }
+};
+
+struct is_even {
+    constexpr bool operator()(int x) const { return x % 2 == 0; }
+};
+
+int main() {
+<% case algorithm
+   when "for_each" %>
+    for_each(range_c<int, 0, <%= n %>>, [](auto i) {
+
+    });
+<% when "foldl" %>
+    static_assert(foldl(range_c<int, 0, <%= n %>>, 0, bit_xor{}) >= 0, "");
+<% when "count" %>
+    static_assert(count(range_c<int, 0, <%= n %>>, is_even{}) >= 0, "");
+<% end %>
+}
@@ -0,0 +1,83 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include TECHNIQUE_HEADER
+#include "../../arena.hpp"
+#include "../../tracked_record.hpp"
+#include "measure.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+// Builds and destroys the objects created to serve a request, with every
+// string and vector allocated either from the global heap or from an arena
+// released after each request. The strings are too long for the small
+// string optimization.
+template <typename Alloc, typename T>
+using rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+template <typename Alloc>
+using string_t = std::basic_string<char, std::char_traits<char>, rebind<Alloc, char>>;
+
+template <typename Alloc, typename T>
+using vector_t = std::vector<T, rebind<Alloc, T>>;
+
+template <typename Alloc>
+using Item = tuple<string_t<Alloc>, string_t<Alloc>, vector_t<Alloc, int>, int>;
+
+template <typename Alloc>
+struct Request {
+    string_t<Alloc> method, path, user;
+    vector_t<Alloc, Item<Alloc>> items;
+};
+
+template <typename Alloc>
+std::size_t serve(Alloc const& a, std::size_t items) {
+    using R = Request<Alloc>;
+    R request = make_record_using_allocator<R,
+        RECORD_MEMBER(R, method), RECORD_MEMBER(R, path),
+        RECORD_MEMBER(R, user), RECORD_MEMBER(R, items)
+    >(a);
+    request.method = "POST";
+    request.path = "/api/v1/orders/submit?format=json";
+    request.user = "user-0123456789abcdef";
+
+    request.items.reserve(items);
+    for (std::size_t i = 0; i < items; ++i) {
+        request.items.push_back(allocate_tuple<
+            string_t<Alloc>, string_t<Alloc>, vector_t<Alloc, int>, int
+        >(a, "product-identifier-0123456789", "a description of the product",
+             std::size_t{8}, static_cast<int>(i)));
+    }
+
+    std::size_t total = request.path.size();
+    for (auto const& item : request.items)
+        total += get<0>(item).size() + get<2>(item).size() + get<3>(item);
+    return total;
+}
+
+template <std::size_t n>
+void benchmark_requests() {
+    double heap = measure(10000000 / (n + 10), [] {
+        do_not_optimize(serve(std::allocator<char>{}, n));
+    });
+    report(std::string{TECHNIQUE} + ".heap", n, "ns", heap);
+
+    static char buffer[64 * 1024];
+    monotonic_arena arena{buffer, sizeof buffer};
+    double monotonic = measure(10000000 / (n + 10), [&] {
+        do_not_optimize(serve(arena_allocator<char>(arena), n));
+        arena.release();
+    });
+    report(std::string{TECHNIQUE} + ".arena", n, "ns", monotonic);
+}
+
+int main() {
+    benchmark_requests<1>();
+    benchmark_requests<10>();
+    benchmark_requests<100>();
+    benchmark_requests<1000>();
+}
@@ -0,0 +1,35 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include TECHNIQUE_HEADER
+#include "measure.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+template <int i>
+struct x { };
+
+// Returns the number of bytes allocated by a vector holding `n` copies of `t`.
+template <typename Tuple>
+std::size_t footprint(std::size_t n, Tuple const& t) {
+    std::vector<Tuple> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        v.push_back(t);
+    do_not_optimize(v.data());
+    return v.capacity() * sizeof(Tuple);
+}
+
+int main() {
+    auto empties = make_tuple(x<1>{}, x<2>{}, x<3>{}, x<4>{},
+                              x<5>{}, x<6>{}, x<7>{}, x<8>{});
+    auto mixed = make_tuple(x<1>{}, 1, x<2>{}, x<3>{}, x<4>{});
+
+    for (std::size_t n : {1000, 10000, 100000, 1000000}) {
+        report(std::string{TECHNIQUE} + ".empties", n, "bytes", footprint(n, empties));
+        report(std::string{TECHNIQUE} + ".mixed", n, "bytes", footprint(n, mixed));
+    }
+}
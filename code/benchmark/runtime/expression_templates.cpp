@@ -0,0 +1,101 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../expression_templates.hpp"
+#include "measure.hpp"
+
+#include <boost/hana/integral.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+using namespace boost::hana::literals;
+
+
+// The multi-pass approach: each operation is a separate pass over its
+// inputs, which writes its result to a temporary.
+Matrix scale(int a, Matrix const& m) {
+    Matrix result(m.rows, m.cols);
+    for (std::size_t k = 0; k < m.storage.size(); ++k)
+        result.storage[k] = a * m.storage[k];
+    return result;
+}
+
+Matrix add(Matrix const& m1, Matrix const& m2) {
+    Matrix result(m1.rows, m1.cols);
+    for (std::size_t k = 0; k < m1.storage.size(); ++k)
+        result.storage[k] = m1.storage[k] + m2.storage[k];
+    return result;
+}
+
+Matrix add_row(Matrix const& m, std::vector<int> const& row) {
+    Matrix result(m.rows, m.cols);
+    for (std::size_t i = 0; i < m.rows; ++i)
+        for (std::size_t j = 0; j < m.cols; ++j)
+            result.storage[i * m.cols + j] = m.storage[i * m.cols + j] + row[j];
+    return result;
+}
+
+std::vector<int> row_sums(Matrix const& m) {
+    std::vector<int> result(m.rows);
+    for (std::size_t i = 0; i < m.rows; ++i)
+        for (std::size_t j = 0; j < m.cols; ++j)
+            result[i] += m.storage[i * m.cols + j];
+    return result;
+}
+
+// Like `mean_along`, the sums are accumulated as `int`s and the means are
+// `double`s, so both approaches compute the same values.
+std::vector<double> column_means(Matrix const& m) {
+    std::vector<int> sums(m.cols);
+    for (std::size_t i = 0; i < m.rows; ++i)
+        for (std::size_t j = 0; j < m.cols; ++j)
+            sums[j] += m.storage[i * m.cols + j];
+    std::vector<double> result(m.cols);
+    for (std::size_t j = 0; j < m.cols; ++j)
+        result[j] = static_cast<double>(sums[j]) / m.rows;
+    return result;
+}
+
+int main() {
+    for (std::size_t n : {64, 256, 1024}) {
+        Matrix m1(n, n), m2(n, n);
+        std::vector<int> row(n);
+        for (std::size_t k = 0; k < n * n; ++k) {
+            m1.storage[k] = static_cast<int>(k % 7);
+            m2.storage[k] = static_cast<int>(k % 11);
+        }
+        for (std::size_t j = 0; j < n; ++j)
+            row[j] = static_cast<int>(j);
+        std::size_t iterations = 64 * 1024 * 1024 / (n * n);
+
+        auto a = terminal(3);
+        auto x = terminal(std::cref(m1));
+        auto y = terminal(std::cref(m2));
+        auto r = broadcast_row(terminal(std::cref(row)));
+
+        // 3 * m1 + m2
+        report("expression_templates.axpy.multi_pass", n, "ns", measure(iterations, [&] {
+            do_not_optimize(add(scale(3, m1), m2).storage.data());
+        }));
+        report("expression_templates.axpy.fused", n, "ns", measure(iterations, [&] {
+            do_not_optimize(stream_eval(a * x + y).storage.data());
+        }));
+
+        // row sums of 3 * m1 + m2
+        report("expression_templates.row_sums.multi_pass", n, "ns", measure(iterations, [&] {
+            do_not_optimize(row_sums(add(scale(3, m1), m2)).data());
+        }));
+        report("expression_templates.row_sums.fused", n, "ns", measure(iterations, [&] {
+            do_not_optimize(stream_eval(sum_along(a * x + y, 1_c)).data());
+        }));
+
+        // column means of m1 with a row added to each row
+        report("expression_templates.column_means.multi_pass", n, "ns", measure(iterations, [&] {
+            do_not_optimize(column_means(add_row(m1, row)).data());
+        }));
+        report("expression_templates.column_means.fused", n, "ns", measure(iterations, [&] {
+            do_not_optimize(stream_eval(mean_along(x + r, 0_c)).data());
+        }));
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../expression_templates.hpp"
+#include "measure.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+
+// A balanced binary tree of `depth` levels adding vectors, with one leaf
+// per element of `leaves`.
+struct add_vectors {
+    std::vector<int> operator()(std::vector<int> const& x, std::vector<int> const& y) const {
+        std::vector<int> result(x.size());
+        for (std::size_t k = 0; k < x.size(); ++k)
+            result[k] = x[k] + y[k];
+        return result;
+    }
+};
+
+template <std::size_t depth>
+struct tree {
+    template <typename Leaf>
+    static auto build(Leaf leaf, std::size_t first) {
+        return function(add_vectors{},
+            tree<depth - 1>::build(leaf, first),
+            tree<depth - 1>::build(leaf, first + (1 << (depth - 1)))
+        );
+    }
+};
+
+template <>
+struct tree<0> {
+    template <typename Leaf>
+    static auto build(Leaf leaf, std::size_t first) { return leaf(first); }
+};
+
+static constexpr std::size_t depth = 6;
+static constexpr std::size_t leaves = 1 << depth;
+
+int main() {
+    for (std::size_t n : {16, 256, 4096}) {
+        std::vector<std::vector<int>> plain(leaves, std::vector<int>(n, 1));
+        std::vector<versioned<std::vector<int>>> stamped(leaves,
+            versioned<std::vector<int>>{std::vector<int>(n, 1)});
+
+        // Recompute the whole tree after each update.
+        auto full = tree<depth>::build([&](std::size_t i) {
+            return terminal(std::cref(plain[i]));
+        }, 0);
+        std::size_t updated = 0;
+        report("incremental_evaluation.full", n, "ns", measure(2000, [&] {
+            plain[updated++ % leaves][0] += 1;
+            do_not_optimize(eval(full)[0]);
+        }));
+
+        // Only recompute the path from the updated leaf to the root.
+        auto incremental_tree = incremental(tree<depth>::build([&](std::size_t i) {
+            return variable(stamped[i]);
+        }, 0));
+        updated = 0;
+        report("incremental_evaluation.incremental", n, "ns", measure(2000, [&] {
+            auto& leaf = stamped[updated++ % leaves];
+            std::vector<int> value = leaf.get();
+            value[0] += 1;
+            leaf.set(std::move(value));
+            do_not_optimize(incremental_tree()[0]);
+        }));
+    }
+}
@@ -0,0 +1,47 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef BENCHMARK_RUNTIME_MEASURE_HPP
+#define BENCHMARK_RUNTIME_MEASURE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+
+// Prevents the compiler from optimizing away the computation of `x`.
+template <typename T>
+void do_not_optimize(T const& x) {
+    asm volatile("" : : "r,m"(x) : "memory");
+}
+
+// Returns the number of nanoseconds taken by a single call to `f`, taking
+// the best of several runs of `iterations` calls to reduce noise.
+template <typename F>
+double measure(std::size_t iterations, F&& f) {
+    using clock = std::chrono::steady_clock;
+    double best = -1;
+    for (int run = 0; run < 5; ++run) {
+        auto start = clock::now();
+        for (std::size_t i = 0; i < iterations; ++i)
+            f();
+        std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+        double per_call = elapsed.count() / iterations;
+        best = best < 0 ? per_call : std::min(best, per_call);
+    }
+    return best;
+}
+
+// Prints a row of results in CSV format.
+//
+// The first column is the name of the benchmark, the second one is the
+// size of the input and the last one is the measured value, whose unit
+// is given in the third column.
+template <typename Value>
+void report(std::string const& name, std::size_t n, std::string const& unit, Value value) {
+    std::cout << name << ',' << n << ',' << unit << ',' << value << std::endl;
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include TECHNIQUE_HEADER
+#include "measure.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+
+template <std::size_t ...i>
+auto make_doubles(std::index_sequence<i...>) {
+    return make_tuple(static_cast<double>(i)...);
+}
+
+template <std::size_t n>
+void benchmark_sum() {
+    auto xs = make_doubles(std::make_index_sequence<n>{});
+    auto plus = [](double x, double y) { return x + y; };
+
+    // Floating point addition is not associative, so the compiler can't turn
+    // the left fold into a tree by itself.
+    double foldl = measure(1000000, [&] {
+        do_not_optimize(xs);
+        do_not_optimize(tuple_foldl(xs, 0.0, plus));
+    });
+    report(std::string{TECHNIQUE} + ".foldl", n, "ns", foldl);
+
+    double reduce = measure(1000000, [&] {
+        do_not_optimize(xs);
+        do_not_optimize(tuple_reduce(xs, 0.0, plus));
+    });
+    report(std::string{TECHNIQUE} + ".reduce", n, "ns", reduce);
+}
+
+int main() {
+    benchmark_sum<8>();
+    benchmark_sum<16>();
+    benchmark_sum<32>();
+    benchmark_sum<64>();
+    benchmark_sum<128>();
+}
@@ -0,0 +1,85 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../segmented_collection.hpp"
+#include "measure.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+
+// The same shapes are stored once behind pointers to a polymorphic base and
+// once by value in a segmented_collection, and the benchmark measures the
+// time taken to compute the total area of the shapes.
+struct shape {
+    virtual double area() const = 0;
+    virtual ~shape() { }
+};
+
+struct circle final : shape {
+    explicit circle(double r) : radius(r) { }
+    double area() const override { return 3.14159 * radius * radius; }
+    double radius;
+};
+
+struct square final : shape {
+    explicit square(double s) : side(s) { }
+    double area() const override { return side * side; }
+    double side;
+};
+
+struct rectangle final : shape {
+    rectangle(double w, double h) : width(w), height(h) { }
+    double area() const override { return width * height; }
+    double width, height;
+};
+
+struct triangle final : shape {
+    triangle(double b, double h) : base(b), height(h) { }
+    double area() const override { return 0.5 * base * height; }
+    double base, height;
+};
+
+int main() {
+    for (std::size_t n : {1000, 100000, 1000000}) {
+        std::mt19937 gen(n);
+        std::uniform_int_distribution<int> kind(0, 3);
+        std::uniform_real_distribution<double> length(1, 10);
+
+        // The shapes are created in random order, as they would be by most
+        // applications, so the pointers are not sorted by type.
+        std::vector<std::unique_ptr<shape>> pointers;
+        segmented_collection<circle, square, rectangle, triangle> segments;
+        for (std::size_t i = 0; i < n; ++i) {
+            double a = length(gen), b = length(gen);
+            switch (kind(gen)) {
+                case 0: pointers.push_back(std::make_unique<circle>(a));
+                        segments.emplace<circle>(a); break;
+                case 1: pointers.push_back(std::make_unique<square>(a));
+                        segments.emplace<square>(a); break;
+                case 2: pointers.push_back(std::make_unique<rectangle>(a, b));
+                        segments.emplace<rectangle>(a, b); break;
+                case 3: pointers.push_back(std::make_unique<triangle>(a, b));
+                        segments.emplace<triangle>(a, b); break;
+            }
+        }
+
+        std::size_t iterations = 100000000 / n;
+        double virtual_calls = measure(iterations, [&] {
+            double total = 0;
+            for (auto const& p : pointers)
+                total += p->area();
+            do_not_optimize(total);
+        });
+        report("segmented_collection.virtual", n, "ns", virtual_calls / n);
+
+        double segmented = measure(iterations, [&] {
+            double total = 0;
+            segments.for_each([&](auto const& s) { total += s.area(); });
+            do_not_optimize(total);
+        });
+        report("segmented_collection.segmented", n, "ns", segmented / n);
+    }
+}
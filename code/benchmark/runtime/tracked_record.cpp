@@ -0,0 +1,73 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../tracked_record.hpp"
+#include "measure.hpp"
+
+#include <string>
+
+
+// A record with 20 members, of which a single one changes between two
+// replications.
+struct Quote {
+    std::string symbol, venue, currency, trader;
+    int id, bid_size, ask_size, last_size, volume, trades;
+    double bid, ask, last, open, high, low, close, vwap;
+    int sequence;
+    std::string comment;
+};
+
+using TrackedQuote = tracked<Quote,
+    RECORD_MEMBER(Quote, symbol), RECORD_MEMBER(Quote, venue),
+    RECORD_MEMBER(Quote, currency), RECORD_MEMBER(Quote, trader),
+    RECORD_MEMBER(Quote, id), RECORD_MEMBER(Quote, bid_size),
+    RECORD_MEMBER(Quote, ask_size), RECORD_MEMBER(Quote, last_size),
+    RECORD_MEMBER(Quote, volume), RECORD_MEMBER(Quote, trades),
+    RECORD_MEMBER(Quote, bid), RECORD_MEMBER(Quote, ask),
+    RECORD_MEMBER(Quote, last), RECORD_MEMBER(Quote, open),
+    RECORD_MEMBER(Quote, high), RECORD_MEMBER(Quote, low),
+    RECORD_MEMBER(Quote, close), RECORD_MEMBER(Quote, vwap),
+    RECORD_MEMBER(Quote, sequence), RECORD_MEMBER(Quote, comment)
+>;
+
+int main() {
+    TrackedQuote quote{Quote{
+        "ACME", "XNAS", "USD", "trader-0001",
+        1, 100, 200, 50, 100000, 1234,
+        10.0, 10.5, 10.25, 9.5, 11.0, 9.0, 10.1, 10.2,
+        0, "no comment for this quote"
+    }};
+    int sequence = 0;
+    std::string out;
+
+    std::size_t full_bytes = 0;
+    double full = measure(100000, [&] {
+        quote.set<RECORD_MEMBER(Quote, sequence)>(++sequence);
+        out.clear();
+        quote.encode_full(out);
+        quote.clear();
+        full_bytes = out.size();
+        do_not_optimize(out);
+    });
+    report("tracked_record.encode_full", 20, "ns", full);
+    report("tracked_record.encode_full", 20, "bytes", full_bytes);
+
+    std::size_t delta_bytes = 0;
+    double delta = measure(100000, [&] {
+        quote.set<RECORD_MEMBER(Quote, sequence)>(++sequence);
+        out.clear();
+        quote.encode_delta(out);
+        quote.clear();
+        delta_bytes = out.size();
+        do_not_optimize(out);
+    });
+    report("tracked_record.encode_delta", 20, "ns", delta);
+    report("tracked_record.encode_delta", 20, "bytes", delta_bytes);
+
+    TrackedQuote replica;
+    double apply = measure(100000, [&] {
+        replica.apply_delta(out);
+        do_not_optimize(replica.record());
+    });
+    report("tracked_record.apply_delta", 20, "ns", apply);
+}
@@ -0,0 +1,36 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include TECHNIQUE_HEADER
+#include "measure.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+int main() {
+    auto t = make_tuple(1, 2.f, 3.0, 4l);
+    using Tuple = decltype(t);
+
+    for (std::size_t n : {1000, 10000, 100000, 1000000}) {
+        // Growing a vector without reserving memory first; each reallocation
+        // moves the elements to the new buffer.
+        double growth = measure(10, [&] {
+            std::vector<Tuple> v;
+            for (std::size_t i = 0; i < n; ++i)
+                v.push_back(t);
+            do_not_optimize(v.data());
+        });
+        report(std::string{TECHNIQUE} + ".growth", n, "ns", growth);
+
+        // Copying a whole buffer into another one, as in a ring buffer.
+        std::vector<Tuple> src(n, t), dest(n, t);
+        double copy = measure(10, [&] {
+            std::copy(src.begin(), src.end(), dest.begin());
+            do_not_optimize(dest.data());
+        });
+        report(std::string{TECHNIQUE} + ".bulk_copy", n, "ns", copy);
+    }
+}
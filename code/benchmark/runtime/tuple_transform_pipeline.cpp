@@ -0,0 +1,68 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include TECHNIQUE_HEADER
+#include "measure.hpp"
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+
+template <std::size_t stages>
+using stages_c = std::integral_constant<std::size_t, stages>;
+
+template <typename Tuple, typename F>
+decltype(auto) eager(Tuple&& ts, F const&, stages_c<0>) {
+    return std::forward<Tuple>(ts);
+}
+
+template <typename Tuple, typename F, std::size_t stages>
+auto eager(Tuple&& ts, F const& f, stages_c<stages>) {
+    return eager(tuple_transform(std::forward<Tuple>(ts), f), f, stages_c<stages - 1>{});
+}
+
+template <typename Tuple, typename F>
+decltype(auto) lazy(Tuple&& ts, F const&, stages_c<0>) {
+    return std::forward<Tuple>(ts);
+}
+
+template <typename Tuple, typename F, std::size_t stages>
+auto lazy(Tuple&& ts, F const& f, stages_c<stages>) {
+    return lazy(tuple_transform_view(std::forward<Tuple>(ts), f), f, stages_c<stages - 1>{});
+}
+
+template <std::size_t stages>
+void benchmark_pipeline() {
+    auto xs = make_tuple(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0);
+    auto f = [](double x) { return x * 1.0001 + 1.0; };
+    auto sum = [](auto ...x) {
+        double total = 0;
+        using swallow = double[];
+        (void)swallow{0.0, (total += x)...};
+        return total;
+    };
+
+    double eager_time = measure(1000000, [&] {
+        do_not_optimize(xs);
+        do_not_optimize(::apply(sum, eager(xs, f, stages_c<stages>{})));
+    });
+    report(std::string{TECHNIQUE} + ".eager", stages, "ns", eager_time);
+
+    double lazy_time = measure(1000000, [&] {
+        do_not_optimize(xs);
+        do_not_optimize(::apply(sum, lazy(xs, f, stages_c<stages>{})));
+    });
+    report(std::string{TECHNIQUE} + ".lazy", stages, "ns", lazy_time);
+}
+
+int main() {
+    benchmark_pipeline<3>();
+    benchmark_pipeline<4>();
+    benchmark_pipeline<5>();
+    benchmark_pipeline<6>();
+    benchmark_pipeline<7>();
+    benchmark_pipeline<8>();
+    benchmark_pipeline<9>();
+    benchmark_pipeline<10>();
+}
@@ -0,0 +1,107 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../variant.hpp"
+#include "measure.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#if __cplusplus > 201402L
+#   include <variant>
+#endif
+
+
+static constexpr std::size_t elements = 4096;
+
+template <int i>
+struct alternative { int value; };
+
+struct base {
+    virtual int value() const = 0;
+    virtual ~base() = default;
+};
+
+template <int i>
+struct derived : base {
+    explicit derived(int v) : v_(v) { }
+    int value() const override { return v_ + i; }
+    int v_;
+};
+
+struct value_of {
+    template <int i>
+    int operator()(alternative<i> const& a) const { return a.value + i; }
+};
+
+template <typename Variant, typename Alternative>
+Variant make_as(int v) { return Variant{Alternative{v}}; }
+
+template <int i>
+std::unique_ptr<base> make_derived(int v) { return std::make_unique<derived<i>>(v); }
+
+template <int ...i>
+void run(std::integer_sequence<int, i...>) {
+    constexpr std::size_t n = sizeof...(i);
+    std::mt19937 gen{0};
+    std::uniform_int_distribution<int> which{0, static_cast<int>(n) - 1};
+    std::vector<int> indices;
+    for (std::size_t k = 0; k < elements; ++k)
+        indices.push_back(which(gen));
+
+    auto sum_all = [](auto const& xs, auto get_value) {
+        int sum = 0;
+        for (auto const& x : xs)
+            sum += get_value(x);
+        return sum;
+    };
+
+    {
+        using V = variant<alternative<i>...>;
+        V (*make[])(int) = {&make_as<V, alternative<i>>...};
+        std::vector<V> xs;
+        for (int k : indices)
+            xs.push_back(make[k](k));
+        double t = measure(1000, [&] {
+            do_not_optimize(sum_all(xs, [](V const& v) { return visit(value_of{}, v); }));
+        });
+        report("variant.visit", n, "ns", t / elements);
+    }
+
+    {
+        std::unique_ptr<base> (*make[])(int) = {&make_derived<i>...};
+        std::vector<std::unique_ptr<base>> xs;
+        for (int k : indices)
+            xs.push_back(make[k](k));
+        double t = measure(1000, [&] {
+            do_not_optimize(sum_all(xs, [](auto const& p) { return p->value(); }));
+        });
+        report("virtual.call", n, "ns", t / elements);
+    }
+
+#if __cplusplus > 201402L
+    {
+        using V = std::variant<alternative<i>...>;
+        V (*make[])(int) = {&make_as<V, alternative<i>>...};
+        std::vector<V> xs;
+        for (int k : indices)
+            xs.push_back(make[k](k));
+        double t = measure(1000, [&] {
+            do_not_optimize(sum_all(xs, [](V const& v) { return std::visit(value_of{}, v); }));
+        });
+        report("std_variant.visit", n, "ns", t / elements);
+    }
+#endif
+}
+
+int main() {
+    run(std::make_integer_sequence<int, 2>{});
+    run(std::make_integer_sequence<int, 4>{});
+    run(std::make_integer_sequence<int, 8>{});
+    run(std::make_integer_sequence<int, 16>{});
+    run(std::make_integer_sequence<int, 32>{});
+    run(std::make_integer_sequence<int, 64>{});
+}
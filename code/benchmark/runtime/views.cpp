@@ -0,0 +1,36 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../lambda_tuple.hpp"
+#include "measure.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+int main() {
+    for (std::size_t n : {16, 256, 4096, 65536}) {
+        std::string s(n, 'x');
+        std::vector<int> v(n, 1);
+        auto ts = make_tuple(s, v, s, v, s, v, s, v);
+
+        auto total_size = [](auto const& window) {
+            std::size_t size = 0;
+            tuple_for_each(window, [&](auto const& x) { size += x.size(); });
+            return size;
+        };
+
+        // Looking at a window by copying it into a new tuple.
+        double eager = measure(10000, [&] {
+            do_not_optimize(total_size(materialize(slice_c<2, 6>(ts))));
+        });
+        report("lambda_tuple.eager_slice", n, "ns", eager);
+
+        // Looking at the same window through a view.
+        double lazy = measure(10000, [&] {
+            do_not_optimize(total_size(slice_c<2, 6>(ts)));
+        });
+        report("lambda_tuple.view_slice", n, "ns", lazy);
+    }
+}
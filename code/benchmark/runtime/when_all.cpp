@@ -0,0 +1,111 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../../when_all.hpp"
+#include "measure.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// A minimal fixed-size thread pool.
+class thread_pool {
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+
+public:
+    explicit thread_pool(std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            workers_.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock{mutex_};
+                        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty())
+                            return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    template <typename F>
+    void submit(F f) {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.emplace_back(std::move(f));
+        }
+        cv_.notify_one();
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_)
+            w.join();
+    }
+};
+
+// Simulates a backend taking `us` microseconds to answer.
+template <typename T>
+T backend(T value, int us) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::microseconds{us};
+    while (std::chrono::steady_clock::now() < until)
+        ;
+    return value;
+}
+
+int main() {
+    thread_pool pool{4};
+    auto combine = [](int a, long b, double c) { return a + b + c; };
+
+    // The first backend is the slowest, so waiting on each result in turn
+    // wastes nothing. The last one is the slowest, so the waiting thread is
+    // woken up for each result before the last.
+    for (int slow : {0, 2}) {
+        int delays[] = {10, 10, 10};
+        delays[slow] = 200;
+
+        double blocking = measure(200, [&] {
+            // `set_value` may still be running on the worker when `get`
+            // returns, so the tasks share the ownership of the promises.
+            auto pa = std::make_shared<std::promise<int>>();
+            auto pb = std::make_shared<std::promise<long>>();
+            auto pc = std::make_shared<std::promise<double>>();
+            auto ts = std::make_tuple(pa->get_future(), pb->get_future(), pc->get_future());
+            pool.submit([=] { pa->set_value(backend(1, delays[0])); });
+            pool.submit([=] { pb->set_value(backend(2l, delays[1])); });
+            pool.submit([=] { pc->set_value(backend(3.0, delays[2])); });
+            do_not_optimize(combine(get<0>(ts).get(), get<1>(ts).get(), get<2>(ts).get()));
+        });
+        report("blocking_get", slow, "ns", blocking);
+
+        double async = measure(200, [&] {
+            eventual<int> a; eventual<long> b; eventual<double> c;
+            auto result = async_apply(combine, std::make_tuple(a, b, c));
+            pool.submit([=] { a.set_value(backend(1, delays[0])); });
+            pool.submit([=] { b.set_value(backend(2l, delays[1])); });
+            pool.submit([=] { c.set_value(backend(3.0, delays[2])); });
+            do_not_optimize(result.get());
+        });
+        report("async_apply", slow, "ns", async);
+    }
+}
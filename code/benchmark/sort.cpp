@@ -0,0 +1,38 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+<% if technique == "hana" %>
+#include <boost/hana/functional/on.hpp>
+#include <boost/hana/orderable/orderable.hpp>
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/type.hpp>
+using namespace boost::hana;
+<% else %>
+#include "../type_sort.hpp"
+#include <functional>
+<% end %>
+
+#include <type_traits>
+
+
+template <int i>
+struct x { };
+
+// Shuffles the keys so the input is not already sorted.
+template <typename T>
+struct key;
+
+template <int i>
+struct key<x<i>> : std::integral_constant<int, (i * 7919) % 503> { };
+
+<% xs = (1..n).map { |i| "x<#{i}>" }.join(', ') %>
+
+int main() {
+<% if technique == "hana" %>
+    auto sorted = sort_by(less ^on^ trait<key>, tuple(
+        <%= (1..n).map { |i| "type<x<#{i}>>" }.join(', ') %>
+    ));
+<% else %>
+    using sorted = sort_by_key_t<key, std::less<><%= n > 0 ? ", #{xs}" : "" %>>;
+<% end %>
+}
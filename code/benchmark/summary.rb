@@ -0,0 +1,110 @@
+# Copyright Louis Dionne 2014
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+# Usage: summary.rb <output> <plot>=<datasets>...
+#
+# Writes a Markdown table of the fastest technique for each plot and each
+# size bucket, with one table per (compiler, standard, headers)
+# configuration.
+# `datasets` is a semicolon-separated list of CSV files produced by
+# benchmark.rb. Since the curves are not sampled at the same sizes, they
+# are compared at the upper bound of each bucket by linear interpolation,
+# and a curve which does not reach a bucket does not compete in it.
+#
+# When curves were measured with both the `parsed` and the `precompiled`
+# header modes, another table compares their baseline, i.e. the time at the
+# smallest size measured (usually n = 0), and their slope, fitted by least
+# squares. The difference of the baselines is the cost of parsing the
+# headers saved in each translation unit.
+
+require 'csv'
+require 'pathname'
+
+
+BUCKETS = [50, 500, 5_000, 50_000, 500_000]
+
+output = Pathname.new(ARGV[0]).expand_path
+plots = ARGV[1..-1].map do |argument|
+  plot, datasets = argument.split('=', 2)
+  [plot, datasets.to_s.split(';').map { |dataset| Pathname.new(dataset).expand_path }]
+end
+
+def interpolate(rows, x)
+  rows.each_cons(2) do |a, b|
+    next unless a['x'] <= x && x <= b['x']
+    return a['time'] if a['x'] == b['x']
+    return a['time'] + (b['time'] - a['time']) * (x - a['x']) / Float(b['x'] - a['x'])
+  end
+  rows.size == 1 && rows.first['x'] == x ? rows.first['time'] : nil
+end
+
+def slope(rows)
+  return nil if rows.size < 2
+  mean_x = rows.map { |row| row['x'] }.inject(:+) / Float(rows.size)
+  mean_y = rows.map { |row| row['time'] }.inject(:+) / Float(rows.size)
+  covariance = rows.map { |row| (row['x'] - mean_x) * (row['time'] - mean_y) }.inject(:+)
+  variance = rows.map { |row| (row['x'] - mean_x)**2 }.inject(:+)
+  variance.zero? ? nil : covariance / variance
+end
+
+# curves[configuration][plot][technique] is the sorted rows of a curve, and
+# modes[[plot, technique, compiler]][headers] is the same thing, for each
+# header mode.
+curves = Hash.new { |h, k| h[k] = Hash.new { |h2, k2| h2[k2] = {} } }
+modes = Hash.new { |h, k| h[k] = {} }
+plots.each do |plot, datasets|
+  datasets.select(&:exist?).each do |dataset|
+    technique = dataset.basename.to_s.sub(/\A#{Regexp.escape(plot)}\./, '')
+    table = CSV.read(dataset, headers: true, converters: :numeric)
+    table.group_by { |row| [row['compiler'], row['standard'], row['headers']] }.each do |(compiler, standard, headers), rows|
+      rows = rows.sort_by { |row| row['x'] }
+      compiler = "#{compiler} -std=#{standard}"
+      configuration = headers ? "#{compiler}, #{headers} headers" : compiler
+      curves[configuration][plot][technique] = rows
+      modes[[plot, technique, compiler]][headers] = rows
+    end
+  end
+end
+
+lines = ["# Fastest technique per operation and size", ""]
+curves.keys.sort.each do |configuration|
+  largest = curves[configuration].values.flat_map(&:values)
+                                 .flat_map { |rows| rows.map { |row| row['x'] } }.max || 0
+  buckets = BUCKETS.take_while.with_index { |_, i| i == 0 || BUCKETS[i - 1] < largest }
+
+  lines << "## #{configuration}" << ""
+  lines << "| operation | " + buckets.map { |b| "n <= #{b}" }.join(' | ') + " |"
+  lines << "|---" * (buckets.size + 1) + "|"
+  curves[configuration].keys.sort.each do |plot|
+    cells = buckets.map do |bucket|
+      times = curves[configuration][plot].map do |technique, rows|
+        [technique, interpolate(rows, bucket)]
+      end.reject { |_, time| time.nil? }
+      technique, time = times.min_by { |_, time| time }
+      technique ? "#{technique} (#{time.round(3)} s)" : "-"
+    end
+    lines << "| #{plot} | #{cells.join(' | ')} |"
+  end
+  lines << ""
+end
+
+compared = modes.select { |_, rows| rows.key?('parsed') && rows.key?('precompiled') }
+unless compared.empty?
+  lines << "## Cost of parsing the headers" << ""
+  lines << "| operation | technique | configuration | baseline parsed (s) | baseline precompiled (s) " +
+           "| saved per TU (s) | slope parsed (ms/element) | slope precompiled (ms/element) |"
+  lines << "|---" * 8 + "|"
+  compared.keys.sort.each do |plot, technique, compiler|
+    parsed, precompiled = compared[[plot, technique, compiler]].values_at('parsed', 'precompiled')
+    baselines = [parsed, precompiled].map { |rows| rows.first['time'] }
+    slopes = [parsed, precompiled].map { |rows| slope(rows) }.map { |s| s ? (s * 1000).round(4) : '-' }
+    lines << "| #{plot} | #{technique} | #{compiler} | " +
+             "#{baselines[0].round(3)} | #{baselines[1].round(3)} | " +
+             "#{(baselines[0] - baselines[1]).round(3)} | #{slopes[0]} | #{slopes[1]} |"
+  end
+  lines << ""
+end
+
+output.dirname.mkpath
+output.write(lines.join("\n"))
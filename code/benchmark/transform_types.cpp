@@ -0,0 +1,35 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+<% if technique != "transform_t" %>
+#include <boost/hana/functor.hpp>
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/type.hpp>
+#include "../type_list_hana.hpp"
+using namespace boost::hana;
+<% else %>
+#include "../type_list.hpp"
+<% end %>
+
+#include <type_traits>
+
+
+template <int i>
+struct x { };
+
+int main() {
+<% case technique
+   when "fmap" %>
+    auto result = fmap(tuple(
+        <%= (1..n).map { |i| "type<x<#{i}>>" }.join(', ') %>
+    ), metafunction<std::add_pointer>);
+<% when "metafunction_all" %>
+    auto result = to_types(unpack(tuple(
+        <%= (1..n).map { |i| "type<x<#{i}>>" }.join(', ') %>
+    ), metafunction_all<std::add_pointer>));
+<% when "transform_t" %>
+    using result = transform_t<std::add_pointer, type_list<
+        <%= (1..n).map { |i| "x<#{i}>" }.join(', ') %>
+    >>;
+<% end %>
+}
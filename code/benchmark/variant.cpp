@@ -0,0 +1,25 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "../variant.hpp"
+
+
+template <int i>
+struct x { };
+
+struct f {
+    template <typename ...T>
+    int operator()(T const& ...) const { return sizeof...(T); }
+};
+
+<% xs = (1..n).map { |i| "x<#{i}>" }.join(', ') %>
+
+int main() {
+    variant<<%= xs %>> v{x<<%= n %>>{}};
+<% if visited == 1 %>
+    return visit(f{}, v);
+<% else %>
+    variant<<%= xs %>> w{x<1>{}};
+    return visit(f{}, v, w);
+<% end %>
+}
@@ -0,0 +1,152 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef EBO_TUPLE_HPP
+#define EBO_TUPLE_HPP
+
+#include "uses_allocator.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// std::tuple and std::make_tuple
+//////////////////////////////////////////////////////////////////////////////
+// This is the same technique as in lambda_tuple.hpp, except the elements are
+// not captured in a lambda. A closure type may well be trivially copyable,
+// but its copy assignment operator is deleted, so a tuple holding one can't
+// be assigned to, let alone trivially. Closures also give each element its
+// own data member, so that even empty elements take at least one byte.
+// Instead, we use an equivalent function object which inherits from the
+// empty elements (the empty base optimization) and holds the other ones as
+// members. Its special members are all defaulted, so it is trivially
+// copyable and trivially assignable whenever the elements are.
+template <std::size_t i, typename T,
+          bool = std::is_empty<T>::value && !std::is_final<T>::value>
+struct ebo;
+
+template <std::size_t i, typename T>
+struct ebo<i, T, true> : T {
+    ebo() = default;
+    template <typename U>
+    explicit constexpr ebo(U&& u) : T(std::forward<U>(u)) { }
+    constexpr T const& get() const { return *this; }
+};
+
+template <std::size_t i, typename T>
+struct ebo<i, T, false> {
+    T value;
+    ebo() = default;
+    template <typename U>
+    explicit constexpr ebo(U&& u) : value(std::forward<U>(u)) { }
+    constexpr T const& get() const { return value; }
+};
+
+template <typename Indices, typename ...T>
+struct storage;
+
+template <std::size_t ...i, typename ...T>
+struct storage<std::index_sequence<i...>, T...> : ebo<i, T>... {
+    storage() = default;
+
+    template <typename ...U, typename = std::enable_if_t<
+        sizeof...(U) == sizeof...(T) && (sizeof...(U) > 0)
+    >>
+    explicit constexpr storage(U&& ...u)
+        : ebo<i, T>(std::forward<U>(u))...
+    { }
+
+    template <typename F>
+    constexpr decltype(auto) operator()(F&& f) const {
+        return std::forward<F>(f)(static_cast<ebo<i, T> const&>(*this).get()...);
+    }
+};
+
+template <typename ...T>
+struct tuple {
+    using Storage = storage<std::index_sequence_for<T...>, T...>;
+    Storage unpack_into{};
+
+    // The elements are value-initialized, like those of `std::tuple`.
+    tuple() = default;
+
+    // Without the last condition, this would be selected over the copy
+    // constructor when copying from a non-const lvalue.
+    template <typename ...U, typename = std::enable_if_t<
+        sizeof...(U) == sizeof...(T) && (sizeof...(U) > 0) &&
+        !is_same_tuple<tuple, U...>::value &&
+        !starts_with_allocator_arg<U...>::value
+    >>
+    /* constexpr */ explicit tuple(U&& ...u)
+        : unpack_into(std::forward<U>(u)...)
+    { }
+
+    // Like `std::tuple`, the elements are constructed with the allocator
+    // given after `std::allocator_arg` whenever they use one.
+    template <typename Alloc>
+    tuple(std::allocator_arg_t, Alloc const& a)
+        : unpack_into(make_using_allocator<T>(a)...)
+    { }
+
+    template <typename Alloc, typename ...U, typename = std::enable_if_t<
+        sizeof...(U) == sizeof...(T) && (sizeof...(U) > 0) &&
+        !is_same_tuple<tuple, U...>::value
+    >>
+    tuple(std::allocator_arg_t, Alloc const& a, U&& ...u)
+        : unpack_into(make_using_allocator<T>(a, std::forward<U>(u))...)
+    { }
+
+    // Since the elements can only be accessed as const, the elements are
+    // copied with the new allocator even when `other` is an rvalue.
+    template <typename Alloc>
+    tuple(std::allocator_arg_t, Alloc const& a, tuple const& other)
+        : unpack_into(other.unpack_into([&a](auto const& ...x) {
+            return Storage(make_using_allocator<T>(a, x)...);
+        }))
+    { }
+};
+
+// The storage takes no space for the empty elements and it preserves the
+// triviality of the elements; these are the reasons for this backend.
+namespace ebo_tuple_checks {
+    template <int i>
+    struct empty { };
+
+    struct final_empty final { };
+
+    struct not_trivial {
+        not_trivial() = default;
+        not_trivial(not_trivial const&) { }
+    };
+
+    static_assert(sizeof(tuple<>) == 1, "");
+    static_assert(sizeof(tuple<empty<1>>) == 1, "");
+    static_assert(sizeof(tuple<empty<1>, empty<2>, empty<3>, empty<4>>) == 1, "");
+    static_assert(sizeof(tuple<int, empty<1>, empty<2>>) == sizeof(int), "");
+    static_assert(sizeof(tuple<empty<1>, int, empty<2>>) == sizeof(int), "");
+
+    // final types can't be used as base classes, so they are stored as members.
+    static_assert(sizeof(tuple<final_empty, int>) == 2 * sizeof(int), "");
+
+    using T = tuple<int, float, empty<1>>;
+    static_assert(std::is_trivially_copyable<T>::value, "");
+    static_assert(std::is_trivially_copy_constructible<T>::value, "");
+    static_assert(std::is_trivially_move_constructible<T>::value, "");
+    static_assert(std::is_trivially_copy_assignable<T>::value, "");
+    static_assert(std::is_trivially_move_assignable<T>::value, "");
+    static_assert(std::is_trivially_destructible<T>::value, "");
+
+    // The non-empty elements live in different base classes, so standard
+    // layout is only preserved when there is at most one of them.
+    static_assert(std::is_standard_layout<tuple<empty<1>, int, empty<2>>>::value, "");
+    static_assert(std::is_standard_layout<tuple<empty<1>, empty<2>>>::value, "");
+
+    static_assert(!std::is_trivially_copyable<tuple<not_trivial, int>>::value, "");
+}
+
+#include "tuple_algorithms.hpp"
+
+#endif
@@ -1,152 +1,19 @@
 // Copyright Louis Dionne 2014
 // Distributed under the Boost Software License, Version 1.0.
 
+#include "expression_templates.hpp"
+
 #include <boost/hana/detail/assert.hpp>
 #include <boost/hana/functional/placeholder.hpp>
 #include <boost/hana/integral.hpp>
-#include <boost/hana/tuple.hpp>
 
-#include <type_traits>
+#include <functional>
 #include <utility>
 #include <vector>
 using namespace boost::hana;
 using namespace literals;
 
 
-//////////////////////////////////////////////////////////////////////////////
-// Tree creation
-//////////////////////////////////////////////////////////////////////////////
-template <typename T> struct treeify : std::false_type { };
-template <typename T> struct treeify<T const> : treeify<T> { };
-template <typename T> struct treeify<T&> : treeify<T> { };
-template <typename T> struct treeify<T&&> : treeify<T> { };
-
-
-template <typename Derived>
-struct expression_base;
-
-template <typename X>
-struct terminal_type : expression_base<terminal_type<X>> {
-    X value;
-
-    explicit constexpr terminal_type(X x)
-        : value(x)
-    { }
-};
-
-template <typename F, typename ...Args>
-struct function_type : expression_base<function_type<F, Args...>> {
-    F value;
-    using Storage = decltype(tuple(std::declval<Args>()...));
-    Storage args;
-
-    explicit constexpr function_type(F f, Args ...a)
-        : value(f), args(tuple(a...))
-    { }
-};
-
-auto terminal = [](auto x) {
-    return terminal_type<decltype(x)>(x);
-};
-
-auto function = [](auto f, auto ...args) {
-    return function_type<decltype(f), decltype(args)...>(f, args...);
-};
-
-struct subscript_tag {
-    template <typename T, typename I>
-    constexpr decltype(auto) operator()(T&& t, I&& i) const
-    { return std::forward<T>(t)[std::forward<I>(i)]; }
-};
-
-template <typename Derived>
-struct expression_base {
-    template <typename T>
-    constexpr decltype(auto) operator[](T&& t) const {
-        return function(subscript_tag{},
-            static_cast<Derived const&>(*this),
-            std::forward<T>(t)
-        );
-    }
-};
-
-
-template <typename X>
-struct treeify<terminal_type<X>> : std::true_type { };
-
-template <typename F, typename ...Args>
-struct treeify<function_type<F, Args...>> : std::true_type { };
-
-#define TREEIFY_BINARY_OP(OP, TAG)                                          \
-    struct TAG {                                                            \
-        template <typename T, typename U>                                   \
-        constexpr decltype(auto) operator()(T&& t, U&& u) const             \
-        { return std::forward<T>(t) OP std::forward<U>(u); }                \
-    };                                                                      \
-                                                                            \
-    template <typename T, typename U, typename = std::enable_if_t<          \
-        treeify<T>::value && treeify<U>::value                              \
-    >>                                                                      \
-    constexpr decltype(auto) operator OP (T&& t, U&& u) {                   \
-        return function(TAG{}, std::forward<T>(t), std::forward<U>(u));     \
-    }                                                                       \
-    static_assert(true, "this is used just to allow a trailing semicolon")  \
-/**/
-
-TREEIFY_BINARY_OP(+, plus_tag);
-TREEIFY_BINARY_OP(-, minus_tag);
-TREEIFY_BINARY_OP(*, times_tag);
-TREEIFY_BINARY_OP(/, divide_tag);
-
-template <typename Derived>
-struct evaluator {
-    template <typename F, typename ...Args>
-    constexpr decltype(auto) operator()(function_type<F, Args...> f) const {
-        return boost::hana::unpack(
-            boost::hana::fmap(f.args, static_cast<Derived const&>(*this)),
-            f.value
-        );
-    }
-
-    template <typename X>
-    constexpr decltype(auto) operator()(terminal_type<X> x) const {
-        return x.value;
-    }
-};
-
-constexpr struct eval_type : evaluator<eval_type> { } eval{};
-
-
-//////////////////////////////////////////////////////////////////////////////
-// Matrix
-//////////////////////////////////////////////////////////////////////////////
-struct Matrix {
-    // storage[i][j] means the (i,j)th element in the matrix.
-    using Row = std::vector<int>;
-    std::vector<Row> storage;
-
-    decltype(auto) operator[](std::pair<int, int> index) const
-    { return storage[index.first][index.second]; }
-};
-
-constexpr struct matrix_evaluator : evaluator<matrix_evaluator> {
-    template <typename Index, typename M1, typename M2>
-    constexpr decltype(auto) operator()(
-        function_type<subscript_tag,
-            function_type<plus_tag, M1, M2>,
-            terminal_type<Index>
-        > expr
-    ) const {
-        auto sum = expr.args[0_c];
-        auto index = expr.args[1_c];
-        return (*this)(sum.args[0_c][index]) +
-               (*this)(sum.args[1_c][index]);
-    }
-
-    using evaluator<matrix_evaluator>::operator();
-} matrix_eval{};
-
-
 //////////////////////////////////////////////////////////////////////////////
 // Tests
 //////////////////////////////////////////////////////////////////////////////
@@ -182,4 +49,78 @@ int main() {
             ]
         ) == 3 + 7 + 11);
     }
+
+    // stream_eval
+    {
+        Matrix m1{{1, 2, 3}, {4, 5, 6}},
+               m2{{7, 8, 9}, {10, 11, 12}};
+        std::vector<int> row{100, 200, 300};
+
+        // scalar * matrix + matrix
+        Matrix r = stream_eval(terminal(2) * terminal(m1) + terminal(std::cref(m2)));
+        BOOST_HANA_RUNTIME_ASSERT(r.rows == 2 && r.cols == 3);
+        BOOST_HANA_RUNTIME_ASSERT(r.storage == (std::vector<int>{9, 12, 15, 18, 21, 24}));
+
+        // broadcast a row
+        Matrix b = stream_eval(terminal(m1) + broadcast_row(terminal(std::cref(row))));
+        BOOST_HANA_RUNTIME_ASSERT(b.storage == (std::vector<int>{101, 202, 303, 104, 205, 306}));
+
+        // reductions
+        BOOST_HANA_RUNTIME_ASSERT(stream_eval(sum_along(terminal(m1), 1_c))
+            == (std::vector<int>{6, 15}));
+        BOOST_HANA_RUNTIME_ASSERT(stream_eval(sum_along(terminal(m1), 0_c))
+            == (std::vector<int>{5, 7, 9}));
+        BOOST_HANA_RUNTIME_ASSERT(stream_eval(max_along(terminal(m2) - terminal(m1), 1_c))
+            == (std::vector<int>{6, 6}));
+        BOOST_HANA_RUNTIME_ASSERT(stream_eval(mean_along(terminal(m1) + terminal(m2), 0_c))
+            == (std::vector<double>{11, 13, 15}));
+        BOOST_HANA_RUNTIME_ASSERT(stream_eval(mean_along(terminal(m1), 0_c))
+            == (std::vector<double>{2.5, 3.5, 4.5}));
+        BOOST_HANA_RUNTIME_ASSERT(stream_eval(
+            sum_along(terminal(3) * terminal(m1) + broadcast_row(terminal(row)), 1_c)
+        ) == (std::vector<int>{618, 645}));
+
+        // the operands must have the same shape
+        auto throws_mismatch = [](auto const& expr) {
+            try { stream_eval(expr); }
+            catch (shape_mismatch const&) { return true; }
+            return false;
+        };
+        Matrix m3{{1, 2}, {3, 4}, {5, 6}};
+        std::vector<int> short_row{1, 2};
+        BOOST_HANA_RUNTIME_ASSERT(throws_mismatch(terminal(m1) + terminal(m3)));
+        BOOST_HANA_RUNTIME_ASSERT(throws_mismatch(terminal(m1) + broadcast_row(terminal(short_row))));
+        BOOST_HANA_RUNTIME_ASSERT(throws_mismatch(sum_along(terminal(m1) * terminal(m3), 0_c)));
+    }
+
+    // incremental
+    {
+        int calls = 0;
+        auto plus = [&calls](int x, int y) { ++calls; return x + y; };
+
+        versioned<int> a{1}, b{2}, c{3}, d{4};
+        auto eval_tree = incremental(
+            function(plus,
+                function(plus, variable(a), variable(b)),
+                function(plus, variable(c), terminal(10) * variable(d))
+            )
+        );
+
+        BOOST_HANA_RUNTIME_ASSERT(eval_tree() == 1 + 2 + 3 + 10 * 4);
+        BOOST_HANA_RUNTIME_ASSERT(calls == 3);
+
+        // nothing changed, so nothing is recomputed
+        BOOST_HANA_RUNTIME_ASSERT(eval_tree() == 1 + 2 + 3 + 10 * 4);
+        BOOST_HANA_RUNTIME_ASSERT(calls == 3);
+
+        // only the path from the changed terminal to the root is recomputed
+        a.set(5);
+        BOOST_HANA_RUNTIME_ASSERT(eval_tree() == 5 + 2 + 3 + 10 * 4);
+        BOOST_HANA_RUNTIME_ASSERT(calls == 5);
+
+        d.set(0);
+        c.set(7);
+        BOOST_HANA_RUNTIME_ASSERT(eval_tree() == 5 + 2 + 7 + 10 * 0);
+        BOOST_HANA_RUNTIME_ASSERT(calls == 7);
+    }
 }
@@ -0,0 +1,497 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef EXPRESSION_TEMPLATES_HPP
+#define EXPRESSION_TEMPLATES_HPP
+
+#include <boost/hana/integral.hpp>
+#include <boost/hana/tuple.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Tree creation
+//////////////////////////////////////////////////////////////////////////////
+template <typename T> struct treeify : std::false_type { };
+template <typename T> struct treeify<T const> : treeify<T> { };
+template <typename T> struct treeify<T&> : treeify<T> { };
+template <typename T> struct treeify<T&&> : treeify<T> { };
+
+
+template <typename Derived>
+struct expression_base;
+
+template <typename X>
+struct terminal_type : expression_base<terminal_type<X>> {
+    X value;
+
+    explicit constexpr terminal_type(X x)
+        : value(x)
+    { }
+};
+
+template <typename F, typename ...Args>
+struct function_type : expression_base<function_type<F, Args...>> {
+    F value;
+    using Storage = decltype(boost::hana::tuple(std::declval<Args>()...));
+    Storage args;
+
+    explicit constexpr function_type(F f, Args ...a)
+        : value(f), args(boost::hana::tuple(a...))
+    { }
+};
+
+auto terminal = [](auto x) {
+    return terminal_type<decltype(x)>(x);
+};
+
+auto function = [](auto f, auto ...args) {
+    return function_type<decltype(f), decltype(args)...>(f, args...);
+};
+
+struct subscript_tag {
+    template <typename T, typename I>
+    constexpr decltype(auto) operator()(T&& t, I&& i) const
+    { return std::forward<T>(t)[std::forward<I>(i)]; }
+};
+
+template <typename Derived>
+struct expression_base {
+    template <typename T>
+    constexpr decltype(auto) operator[](T&& t) const {
+        return function(subscript_tag{},
+            static_cast<Derived const&>(*this),
+            std::forward<T>(t)
+        );
+    }
+};
+
+
+template <typename X>
+struct treeify<terminal_type<X>> : std::true_type { };
+
+template <typename F, typename ...Args>
+struct treeify<function_type<F, Args...>> : std::true_type { };
+
+#define TREEIFY_BINARY_OP(OP, TAG)                                          \
+    struct TAG {                                                            \
+        template <typename T, typename U>                                   \
+        constexpr decltype(auto) operator()(T&& t, U&& u) const             \
+        { return std::forward<T>(t) OP std::forward<U>(u); }                \
+    };                                                                      \
+                                                                            \
+    template <typename T, typename U, typename = std::enable_if_t<          \
+        treeify<T>::value && treeify<U>::value                              \
+    >>                                                                      \
+    constexpr decltype(auto) operator OP (T&& t, U&& u) {                   \
+        return function(TAG{}, std::forward<T>(t), std::forward<U>(u));     \
+    }                                                                       \
+    static_assert(true, "this is used just to allow a trailing semicolon")  \
+/**/
+
+TREEIFY_BINARY_OP(+, plus_tag);
+TREEIFY_BINARY_OP(-, minus_tag);
+TREEIFY_BINARY_OP(*, times_tag);
+TREEIFY_BINARY_OP(/, divide_tag);
+
+template <typename Derived>
+struct evaluator {
+    template <typename F, typename ...Args>
+    constexpr decltype(auto) operator()(function_type<F, Args...> f) const {
+        return boost::hana::unpack(
+            boost::hana::fmap(f.args, static_cast<Derived const&>(*this)),
+            f.value
+        );
+    }
+
+    template <typename X>
+    constexpr decltype(auto) operator()(terminal_type<X> x) const {
+        return x.value;
+    }
+};
+
+constexpr struct eval_type : evaluator<eval_type> { } eval{};
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Matrix
+//////////////////////////////////////////////////////////////////////////////
+struct Matrix {
+    // The elements are stored contiguously, row after row, so that a whole
+    // expression can be evaluated in a single pass over the storage.
+    std::size_t rows, cols;
+    std::vector<int> storage;
+
+    Matrix(std::size_t rows, std::size_t cols)
+        : rows(rows), cols(cols), storage(rows * cols)
+    { }
+
+    Matrix(std::initializer_list<std::initializer_list<int>> init)
+        : rows(init.size()), cols(init.size() ? init.begin()->size() : 0)
+    {
+        for (auto const& row : init) {
+            assert(row.size() == cols);
+            storage.insert(storage.end(), row.begin(), row.end());
+        }
+    }
+
+    // (*this)[{i, j}] means the (i,j)th element in the matrix.
+    int operator[](std::pair<int, int> index) const
+    { return storage[index.first * cols + index.second]; }
+};
+
+constexpr struct matrix_evaluator : evaluator<matrix_evaluator> {
+    template <typename Index, typename M1, typename M2>
+    constexpr decltype(auto) operator()(
+        function_type<subscript_tag,
+            function_type<plus_tag, M1, M2>,
+            terminal_type<Index>
+        > expr
+    ) const {
+        using namespace boost::hana::literals;
+        auto sum = expr.args[0_c];
+        auto index = expr.args[1_c];
+        return (*this)(sum.args[0_c][index]) +
+               (*this)(sum.args[1_c][index]);
+    }
+
+    using evaluator<matrix_evaluator>::operator();
+} matrix_eval{};
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Broadcasting and reductions
+//////////////////////////////////////////////////////////////////////////////
+// Element-wise matrix expressions are evaluated by `stream_eval` in a single
+// pass over the storage of the matrices, without creating temporaries for
+// the intermediate results. In such expressions,
+//
+//  - a terminal holding a `Matrix` (or a `std::reference_wrapper` to one, to
+//    avoid copying it into the tree) stands for its elements;
+//  - any other terminal is a scalar broadcast to every element;
+//  - `broadcast_row(row)` repeats a row, given as a terminal holding a
+//    `std::vector<int>` (or a reference to one), on every row.
+//
+// The reductions `sum_along`, `max_along` and `mean_along` reduce an
+// element-wise expression along the rows (axis 0, giving one value per
+// column) or along the columns (axis 1, giving one value per row), during
+// that same pass. `mean_along` gives `double`s; the other reductions give
+// `int`s.
+//
+// The operands of an expression must have the same shape, and a broadcast
+// row must have as many elements as the matrices have columns; otherwise,
+// `shape_mismatch` is thrown before any element is evaluated.
+struct shape_mismatch : std::exception {
+    char const* what() const noexcept override
+    { return "shape_mismatch"; }
+};
+
+struct row_broadcast_tag { };
+
+auto broadcast_row = [](auto row) {
+    return function(row_broadcast_tag{}, row);
+};
+
+struct sum_op {
+    int operator()(int acc, int x) const { return acc + x; }
+    int finish(int acc, std::size_t) const { return acc; }
+};
+
+struct max_op {
+    int operator()(int acc, int x) const { return acc < x ? x : acc; }
+    int finish(int acc, std::size_t) const { return acc; }
+};
+
+struct mean_op : sum_op {
+    double finish(int acc, std::size_t count) const
+    { return static_cast<double>(acc) / count; }
+};
+
+template <typename Op, int axis>
+struct reduce_tag {
+    static_assert(axis == 0 || axis == 1, "a matrix can only be reduced along axis 0 or 1");
+};
+
+template <typename Op, typename Axis, typename Expr>
+auto reduce_along(Expr expr, Axis) {
+    return function(reduce_tag<Op, Axis::value>{}, expr);
+}
+
+auto sum_along = [](auto expr, auto axis) {
+    return reduce_along<sum_op>(expr, axis);
+};
+
+auto max_along = [](auto expr, auto axis) {
+    return reduce_along<max_op>(expr, axis);
+};
+
+auto mean_along = [](auto expr, auto axis) {
+    return reduce_along<mean_op>(expr, axis);
+};
+
+template <typename X>
+X const& unwrap(X const& x) { return x; }
+
+template <typename X>
+X& unwrap(std::reference_wrapper<X> x) { return x.get(); }
+
+inline int element(Matrix const& m, std::size_t i, std::size_t j)
+{ return m.storage[i * m.cols + j]; }
+
+template <typename Scalar, typename = std::enable_if_t<std::is_arithmetic<Scalar>::value>>
+Scalar element(Scalar x, std::size_t, std::size_t)
+{ return x; }
+
+// Evaluates the element at (i, j) of an element-wise expression.
+struct element_at {
+    std::size_t i, j;
+
+    template <typename X>
+    decltype(auto) operator()(terminal_type<X> const& x) const
+    { return element(unwrap(x.value), i, j); }
+
+    template <typename Row>
+    decltype(auto) operator()(function_type<row_broadcast_tag, Row> const& row) const {
+        using namespace boost::hana::literals;
+        return unwrap(row.args[0_c].value)[j];
+    }
+
+    template <typename F, typename ...Args>
+    decltype(auto) operator()(function_type<F, Args...> const& f) const {
+        return boost::hana::unpack(f.args, [this, &f](auto const& ...args) {
+            return f.value((*this)(args)...);
+        });
+    }
+};
+
+// Returns the number of rows and columns of an element-wise expression. A
+// dimension is 0 when it is unknown, like the rows of a broadcast row.
+struct shape_of {
+    struct shape { std::size_t rows, cols; };
+
+    template <typename X>
+    shape operator()(terminal_type<X> const& x) const
+    { return shape_impl(unwrap(x.value)); }
+
+    template <typename Row>
+    shape operator()(function_type<row_broadcast_tag, Row> const& row) const {
+        using namespace boost::hana::literals;
+        return {0, unwrap(row.args[0_c].value).size()};
+    }
+
+    template <typename F, typename ...Args>
+    shape operator()(function_type<F, Args...> const& f) const {
+        return boost::hana::unpack(f.args, [this](auto const& ...args) {
+            shape shapes[] = {{0, 0}, (*this)(args)...};
+            shape result{0, 0};
+            for (shape s : shapes) {
+                if ((result.rows && s.rows && s.rows != result.rows) ||
+                    (result.cols && s.cols && s.cols != result.cols))
+                    throw shape_mismatch{};
+                if (!result.rows) result.rows = s.rows;
+                if (!result.cols) result.cols = s.cols;
+            }
+            return result;
+        });
+    }
+
+private:
+    static shape shape_impl(Matrix const& m) { return {m.rows, m.cols}; }
+
+    template <typename Scalar>
+    static shape shape_impl(Scalar const&) { return {0, 0}; }
+};
+
+constexpr struct stream_evaluator {
+    template <typename Op>
+    using reduction_result = std::vector<decltype(
+        std::declval<Op const&>().finish(0, std::size_t{})
+    )>;
+
+    template <typename Op, typename Expr>
+    reduction_result<Op> operator()(function_type<reduce_tag<Op, 0>, Expr> const& r) const {
+        using namespace boost::hana::literals;
+        auto const& expr = r.args[0_c];
+        auto shape = shape_of{}(expr);
+        assert(shape.rows > 0);
+
+        Op op;
+        std::vector<int> acc(shape.cols);
+        for (std::size_t j = 0; j < shape.cols; ++j)
+            acc[j] = element_at{0, j}(expr);
+        for (std::size_t i = 1; i < shape.rows; ++i)
+            for (std::size_t j = 0; j < shape.cols; ++j)
+                acc[j] = op(acc[j], element_at{i, j}(expr));
+
+        reduction_result<Op> result(shape.cols);
+        for (std::size_t j = 0; j < shape.cols; ++j)
+            result[j] = op.finish(acc[j], shape.rows);
+        return result;
+    }
+
+    template <typename Op, typename Expr>
+    reduction_result<Op> operator()(function_type<reduce_tag<Op, 1>, Expr> const& r) const {
+        using namespace boost::hana::literals;
+        auto const& expr = r.args[0_c];
+        auto shape = shape_of{}(expr);
+        assert(shape.cols > 0);
+
+        Op op;
+        reduction_result<Op> result(shape.rows);
+        for (std::size_t i = 0; i < shape.rows; ++i) {
+            int acc = element_at{i, 0}(expr);
+            for (std::size_t j = 1; j < shape.cols; ++j)
+                acc = op(acc, element_at{i, j}(expr));
+            result[i] = op.finish(acc, shape.cols);
+        }
+        return result;
+    }
+
+    template <typename Expr>
+    Matrix operator()(Expr const& expr) const {
+        auto shape = shape_of{}(expr);
+        Matrix result(shape.rows, shape.cols);
+        int* out = result.storage.data();
+        for (std::size_t i = 0; i < shape.rows; ++i)
+            for (std::size_t j = 0; j < shape.cols; ++j)
+                *out++ = element_at{i, j}(expr);
+        return result;
+    }
+} stream_eval{};
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Incremental evaluation
+//////////////////////////////////////////////////////////////////////////////
+// A `versioned<T>` is a value with a version stamp taken from a global clock
+// each time it is set, and `variable(v)` is a terminal referring to it.
+//
+// An `incremental_evaluator` keeps the last result of every function node of
+// an expression, along with the newest stamp of the terminals it was
+// computed from. When it is called again, a node is only recomputed if one
+// of its terminals was set in the meantime; otherwise its cached result is
+// used, without looking at the function. Terminals which are not `variable`s
+// are considered to never change.
+inline std::size_t next_version() {
+    static std::atomic<std::size_t> clock{0};
+    return ++clock;
+}
+
+template <typename T>
+class versioned {
+    T value_;
+    std::size_t version_;
+
+public:
+    explicit versioned(T value)
+        : value_(std::move(value)), version_(next_version())
+    { }
+
+    T const& get() const { return value_; }
+    std::size_t version() const { return version_; }
+
+    template <typename U>
+    void set(U&& u) {
+        value_ = std::forward<U>(u);
+        version_ = next_version();
+    }
+};
+
+auto variable = [](auto const& v) {
+    return terminal(std::cref(v));
+};
+
+template <typename X>
+X const& value_of(X const& x) { return x; }
+
+template <typename T>
+T const& value_of(versioned<T> const& v) { return v.get(); }
+
+template <typename X>
+std::size_t stamp_of(X const&) { return 0; }
+
+template <typename T>
+std::size_t stamp_of(versioned<T> const& v) { return v.version(); }
+
+// The cache of a node has the same structure as the node itself.
+template <typename Expr>
+struct cache_node;
+
+template <typename X>
+struct cache_node<terminal_type<X>> {
+    using result_type = std::decay_t<decltype(value_of(unwrap(std::declval<X const&>())))>;
+
+    result_type const& eval(terminal_type<X> const& t, std::size_t& stamp) {
+        stamp = stamp_of(unwrap(t.value));
+        return value_of(unwrap(t.value));
+    }
+};
+
+template <typename F, typename ...Args>
+struct cache_node<function_type<F, Args...>> {
+    using result_type = std::decay_t<decltype(std::declval<F const&>()(
+        std::declval<typename cache_node<Args>::result_type const&>()...
+    ))>;
+
+    std::tuple<cache_node<Args>...> children;
+    std::unique_ptr<result_type> value;
+    std::size_t stamp = 0;
+
+    result_type const& eval(function_type<F, Args...> const& f, std::size_t& newest) {
+        return boost::hana::unpack(f.args, [&](auto const& ...args) -> result_type const& {
+            return this->eval_impl(f.value, newest, std::index_sequence_for<Args...>{}, args...);
+        });
+    }
+
+private:
+    template <std::size_t ...i, typename ...A>
+    result_type const& eval_impl(F const& f, std::size_t& newest,
+                                 std::index_sequence<i...>, A const& ...args)
+    {
+        std::size_t stamps[sizeof...(i) + 1] = {};
+        auto results = std::forward_as_tuple(
+            std::get<i>(children).eval(args, stamps[i + 1])...
+        );
+        std::size_t const latest = *std::max_element(std::begin(stamps), std::end(stamps));
+
+        if (!value)
+            value = std::make_unique<result_type>(f(std::get<i>(results)...));
+        else if (latest > stamp)
+            *value = f(std::get<i>(results)...);
+        stamp = latest;
+        newest = latest;
+        return *value;
+    }
+};
+
+template <typename Expr>
+class incremental_evaluator {
+    Expr expr_;
+    cache_node<Expr> cache_;
+
+public:
+    explicit incremental_evaluator(Expr expr) : expr_(std::move(expr)) { }
+
+    typename cache_node<Expr>::result_type const& operator()() {
+        std::size_t stamp;
+        return cache_.eval(expr_, stamp);
+    }
+};
+
+auto incremental = [](auto expr) {
+    return incremental_evaluator<decltype(expr)>(std::move(expr));
+};
+
+#endif
@@ -0,0 +1,46 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "fusion_vector.hpp"
+#include <cassert>
+#include <string>
+#include <utility>
+
+
+struct counter {
+    static int copies;
+    counter() = default;
+    counter(counter&&) = default;
+    counter(counter const&) { ++copies; }
+};
+int counter::copies = 0;
+
+
+int main() {
+    // tuple_foldl and tuple_reduce
+    {
+        auto plus = [](auto x, auto y) { return x + y; };
+        assert(tuple_foldl(make_tuple(), 0, plus) == 0);
+        assert(tuple_foldl(make_tuple(1, 2, 3), 0, plus) == 1 + 2 + 3);
+
+        assert(tuple_reduce(make_tuple(), 0, plus) == 0);
+        assert(tuple_reduce(make_tuple(1), 0, plus) == 1);
+        assert(tuple_reduce(make_tuple(1, 2.5, 3l, 4), 0, plus) == 1 + 2.5 + 3l + 4);
+
+        // The order of the elements is preserved. The call is qualified,
+        // because argument-dependent lookup also finds `std::make_tuple`.
+        auto t = ::make_tuple(std::string{"b"}, std::string{"c"}, std::string{"d"});
+        assert(tuple_reduce(t, std::string{"a"}, plus) == "abcd");
+
+        // Neither the elements nor the intermediate results are copied.
+        auto cs = make_tuple(counter{}, counter{}, counter{}, counter{}, counter{});
+        counter::copies = 0;
+        tuple_reduce(cs, counter{}, [](counter const&, counter const&) {
+            return counter{};
+        });
+        tuple_reduce(cs, counter{}, [](auto&& x, counter const&) -> decltype(auto) {
+            return std::forward<decltype(x)>(x);
+        });
+        assert(counter::copies == 0);
+    }
+}
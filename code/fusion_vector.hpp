@@ -4,14 +4,27 @@
 #ifndef FUSION_VECTOR_HPP
 #define FUSION_VECTOR_HPP
 
-#define FUSION_MAX_VECTOR_SIZE 50
+// Recent versions of Fusion provide a variadic `vector` whenever the
+// compiler supports it, in which case there is no arity limit and
+// FUSION_MAX_VECTOR_SIZE is ignored. Otherwise, we fall back to the
+// preprocessed vectors, which can't go beyond 50 elements.
+#include <boost/fusion/container/vector/detail/config.hpp>
+#if !defined(BOOST_FUSION_HAS_VARIADIC_VECTOR)
+#   define FUSION_MAX_VECTOR_SIZE 50
+#endif
+
 #include <boost/fusion/include/at_c.hpp>
+#include <boost/fusion/include/fold.hpp>
 #include <boost/fusion/include/for_each.hpp>
 #include <boost/fusion/include/join.hpp>
-#include <boost/fusion/include/make_fused.hpp>
+#include <boost/fusion/include/size.hpp>
 #include <boost/fusion/include/transform.hpp>
 #include <boost/fusion/include/vector.hpp>
 
+#include "uses_allocator.hpp"
+
+#include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -27,6 +40,21 @@ constexpr tuple<std::decay_t<T>...> make_tuple(T&& ...t) {
     return tuple<std::decay_t<T>...>{std::forward<T>(t)...};
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical std::allocate_tuple
+//////////////////////////////////////////////////////////////////////////////
+// Fusion's vectors have no allocator-extended constructors, so the elements
+// are constructed with the allocator first and then moved into the vector.
+template <typename ...T, typename Alloc>
+tuple<T...> allocate_tuple(Alloc const& a) {
+    return tuple<T...>(make_using_allocator<T>(a)...);
+}
+
+template <typename ...T, typename Alloc, typename ...U>
+tuple<T...> allocate_tuple(Alloc const& a, U&& ...u) {
+    return tuple<T...>(make_using_allocator<T>(a, std::forward<U>(u))...);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // std::get
 //////////////////////////////////////////////////////////////////////////////
@@ -63,9 +91,22 @@ constexpr decltype(auto) tuple_cat(Xs&& xs, Ys&& ys) {
 //////////////////////////////////////////////////////////////////////////////
 // the proposed C++17 std::apply function
 //////////////////////////////////////////////////////////////////////////////
+// We don't use `boost::fusion::make_fused`, because `boost::fusion::invoke`
+// is limited to BOOST_FUSION_INVOKE_MAX_ARITY arguments (6 by default).
+template <typename F, typename Tuple, std::size_t ...i>
+constexpr decltype(auto) apply_impl(F&& f, Tuple&& ts, std::index_sequence<i...>) {
+    return std::forward<F>(f)(boost::fusion::at_c<i>(std::forward<Tuple>(ts))...);
+}
+
 template <typename F, typename Tuple>
 constexpr decltype(auto) apply(F&& f, Tuple&& ts) {
-    return boost::fusion::make_fused(std::forward<F>(f))(std::forward<Tuple>(ts));
+    return apply_impl(
+        std::forward<F>(f),
+        std::forward<Tuple>(ts),
+        std::make_index_sequence<
+            boost::fusion::result_of::size<std::decay_t<Tuple>>::value
+        >{}
+    );
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -76,6 +117,16 @@ constexpr decltype(auto) tuple_transform(Tuple&& ts, F&& f) {
     return boost::fusion::transform(std::forward<Tuple>(ts), std::forward<F>(f));
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// lazy tuple_transform
+//////////////////////////////////////////////////////////////////////////////
+// `boost::fusion::transform` already returns a lazy `transform_view`, so
+// this is the same as `tuple_transform`.
+template <typename Tuple, typename F>
+constexpr decltype(auto) tuple_transform_view(Tuple&& ts, F&& f) {
+    return boost::fusion::transform(std::forward<Tuple>(ts), std::forward<F>(f));
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // hypothetical `std::tuple_for_each`
 //////////////////////////////////////////////////////////////////////////////
@@ -84,4 +135,68 @@ constexpr void tuple_for_each(Tuple&& ts, F&& f) {
     boost::fusion::for_each(std::forward<Tuple>(ts), std::forward<F>(f));
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical `std::tuple_foldl` and `std::tuple_reduce`
+//////////////////////////////////////////////////////////////////////////////
+// Like in std_tuple.hpp, the levels of `tuple_reduce` refer to their arguments
+// instead of copying them. Fusion's vectors can't hold rvalue references, so
+// the arguments are held through pointers which remember their original
+// value category.
+template <typename Tuple, typename State, typename F>
+constexpr auto tuple_foldl(Tuple&& ts, State&& state, F&& f) {
+    return boost::fusion::fold(std::forward<Tuple>(ts),
+                               std::forward<State>(state),
+                               std::forward<F>(f));
+}
+
+template <typename X>
+struct forwarded {
+    std::remove_reference_t<X>* pointer;
+    constexpr X&& get() const { return static_cast<X&&>(*pointer); }
+};
+
+template <std::size_t k, typename Refs>
+constexpr decltype(auto) forward_at(Refs const& refs) {
+    return boost::fusion::at_c<k>(refs).get();
+}
+
+template <typename F, typename X>
+constexpr auto reduce_impl(F&, X&& x) {
+    return std::forward<X>(x);
+}
+
+template <typename F, typename X1, typename X2, typename ...Xs>
+constexpr auto reduce_impl(F& f, X1&& x1, X2&& x2, Xs&& ...xs);
+
+template <typename F, typename Refs, std::size_t ...i, std::size_t ...last>
+constexpr auto reduce_pairs(F& f, Refs const& refs, std::index_sequence<i...>,
+                                                    std::index_sequence<last...>)
+{
+    return reduce_impl(f, f(forward_at<2*i>(refs), forward_at<2*i+1>(refs))...,
+                          forward_at<last>(refs)...);
+}
+
+template <typename F, typename X1, typename X2, typename ...Xs>
+constexpr auto reduce_impl(F& f, X1&& x1, X2&& x2, Xs&& ...xs) {
+    constexpr std::size_t n = 2 + sizeof...(Xs);
+    return reduce_pairs(f,
+        tuple<forwarded<X1>, forwarded<X2>, forwarded<Xs>...>(
+            forwarded<X1>{std::addressof(x1)}, forwarded<X2>{std::addressof(x2)},
+            forwarded<Xs>{std::addressof(xs)}...
+        ),
+        std::make_index_sequence<n / 2>{},
+        std::conditional_t<n % 2 == 1,
+            std::index_sequence<n - 1>, std::index_sequence<>
+        >{}
+    );
+}
+
+template <typename Tuple, typename State, typename F>
+constexpr auto tuple_reduce(Tuple&& ts, State&& state, F&& f) {
+    return ::apply([&](auto&& ...xs) {
+        return reduce_impl(f, std::forward<State>(state),
+                              std::forward<decltype(xs)>(xs)...);
+    }, std::forward<Tuple>(ts));
+}
+
 #endif
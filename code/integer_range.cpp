@@ -0,0 +1,80 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "integer_range.hpp"
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+
+struct is_even {
+    template <typename T>
+    constexpr bool operator()(T x) const { return x % 2 == 0; }
+};
+
+struct times {
+    template <typename T>
+    constexpr T operator()(T x, T y) const { return x * y; }
+};
+
+int main() {
+    // make_sequence, including the fallback implementation
+    {
+        static_assert(std::is_same<
+            make_sequence<int, 5>, std::integer_sequence<int, 0, 1, 2, 3, 4>
+        >::value, "");
+
+        static_assert(std::is_same<
+            make_sequence_impl<int, 0>::type, std::integer_sequence<int>
+        >::value, "");
+
+        static_assert(std::is_same<
+            make_sequence_impl<int, 7>::type, std::make_integer_sequence<int, 7>
+        >::value, "");
+
+        static_assert(std::is_same<
+            make_sequence_impl<long, 1000>::type, std::make_integer_sequence<long, 1000>
+        >::value, "");
+    }
+
+    // to_sequence
+    {
+        static_assert(std::is_same<
+            decltype(to_sequence(range_c<int, 10, 14>)),
+            std::integer_sequence<int, 10, 11, 12, 13>
+        >::value, "");
+
+        static_assert(std::is_same<
+            decltype(to_sequence(range_c<int, -2, 1>)),
+            std::integer_sequence<int, -2, -1, 0>
+        >::value, "");
+
+        static_assert(std::is_same<
+            decltype(range(std::integral_constant<int, 0>{},
+                           std::integral_constant<int, 3>{})),
+            integer_range<int, 0, 3>
+        >::value, "");
+    }
+
+    // for_each
+    {
+        int sum = 0;
+        for_each(range_c<int, 10, 20>, [&](auto i) {
+            static_assert(decltype(i)::value >= 10, "");
+            sum += decltype(i)::value;
+        });
+        assert(sum == 10 + 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19);
+
+        for_each(range_c<int, 0, 0>, [](auto) { assert(false); });
+    }
+
+    // foldl and count
+    {
+        static_assert(foldl(range_c<int, 1, 5>, 1, times{}) == 24, "");
+        static_assert(count(range_c<int, 0, 10>, is_even{}) == 5, "");
+        static_assert(count(range_c<int, 0, 100000>, is_even{}) == 50000, "");
+
+        using r = std::integral_constant<int, foldl(range_c<int, 1, 5>, 1, times{})>;
+        static_assert(r::value == 24, "");
+    }
+}
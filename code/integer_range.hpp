@@ -0,0 +1,151 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef INTEGER_RANGE_HPP
+#define INTEGER_RANGE_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// make_integer_sequence
+//////////////////////////////////////////////////////////////////////////////
+// Compilers providing a builtin to generate integer sequences can do it in
+// constant time. Otherwise, we split the sequence in two halves, so only
+// O(log n) instantiations are required instead of O(n).
+#if defined(__has_builtin)
+#   if __has_builtin(__make_integer_seq)
+#       define INTEGER_RANGE_MAKE_INTEGER_SEQ
+#   elif __has_builtin(__integer_pack)
+#       define INTEGER_RANGE_INTEGER_PACK
+#   endif
+#endif
+
+template <typename Left, typename Right>
+struct concat_sequences;
+
+template <typename T, T ...i, T ...j>
+struct concat_sequences<std::integer_sequence<T, i...>,
+                        std::integer_sequence<T, j...>>
+{
+    using type = std::integer_sequence<T, i..., (sizeof...(i) + j)...>;
+};
+
+template <typename T, std::size_t n>
+struct make_sequence_impl
+    : concat_sequences<
+        typename make_sequence_impl<T, n / 2>::type,
+        typename make_sequence_impl<T, n - n / 2>::type
+    >
+{ };
+
+template <typename T>
+struct make_sequence_impl<T, 0> { using type = std::integer_sequence<T>; };
+
+template <typename T>
+struct make_sequence_impl<T, 1> { using type = std::integer_sequence<T, 0>; };
+
+#if defined(INTEGER_RANGE_MAKE_INTEGER_SEQ)
+    template <typename T, std::size_t n>
+    using make_sequence = __make_integer_seq<std::integer_sequence, T, n>;
+#elif defined(INTEGER_RANGE_INTEGER_PACK)
+    template <typename T, std::size_t n>
+    using make_sequence = std::integer_sequence<T, __integer_pack(n)...>;
+#else
+    template <typename T, std::size_t n>
+    using make_sequence = typename make_sequence_impl<T, n>::type;
+#endif
+
+//////////////////////////////////////////////////////////////////////////////
+// range_c and range
+//////////////////////////////////////////////////////////////////////////////
+// A range does not hold anything; its elements are only generated, all at
+// once, when an algorithm needs them.
+template <typename T, T from, T to>
+struct integer_range {
+    static_assert(from <= to, "invalid range");
+    static constexpr std::size_t size = static_cast<std::size_t>(to - from);
+};
+
+template <typename T, T from, T to>
+constexpr integer_range<T, from, to> range_c{};
+
+template <typename T, T from, T to>
+constexpr integer_range<T, from, to>
+range(std::integral_constant<T, from>, std::integral_constant<T, to>)
+{ return {}; }
+
+template <typename T, T from, T ...i>
+constexpr std::integer_sequence<T, (from + i)...>
+offset(std::integer_sequence<T, i...>)
+{ return {}; }
+
+template <typename T, T from, T to>
+constexpr auto to_sequence(integer_range<T, from, to>) {
+    return offset<T, from>(make_sequence<T, integer_range<T, from, to>::size>{});
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// for_each
+//////////////////////////////////////////////////////////////////////////////
+// Calls `f` with an `std::integral_constant` for each element of the range,
+// in order. The elements are expanded as a pack instead of recursing on the
+// range one element at a time.
+template <typename T, T ...i, typename F>
+constexpr void for_each_impl(std::integer_sequence<T, i...>, F& f) {
+    using swallow = int[];
+    (void)swallow{1, (f(std::integral_constant<T, i>{}), void(), 1)...};
+}
+
+// Compilers handle very long pack expansions poorly (GCC is quadratic), so
+// large ranges are split in halves until the blocks are small enough to be
+// expanded at once. This requires O(log n) levels of instantiation.
+constexpr std::size_t for_each_block_size = 256;
+
+template <typename T, T from, std::size_t n, typename F>
+constexpr void for_each_block(F& f, std::true_type) {
+    for_each_impl(offset<T, from>(make_sequence<T, n>{}), f);
+}
+
+template <typename T, T from, std::size_t n, typename F>
+constexpr void for_each_block(F& f, std::false_type) {
+    constexpr std::size_t half = n / 2;
+    for_each_block<T, from, half>(f,
+        std::integral_constant<bool, (half <= for_each_block_size)>{});
+    for_each_block<T, from + static_cast<T>(half), n - half>(f,
+        std::integral_constant<bool, (n - half <= for_each_block_size)>{});
+}
+
+template <typename T, T from, T to, typename F>
+constexpr void for_each(integer_range<T, from, to> r, F&& f) {
+    constexpr std::size_t n = decltype(r)::size;
+    for_each_block<T, from, n>(f,
+        std::integral_constant<bool, (n <= for_each_block_size)>{});
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// foldl and count
+//////////////////////////////////////////////////////////////////////////////
+// These don't need a distinct type for each element, so they simply loop
+// over the values of the range without instantiating anything per element.
+// When `f` and `pred` are constexpr, so is the result; wrap it in an
+// `std::integral_constant` to get a compile-time value.
+template <typename T, T from, T to, typename State, typename F>
+constexpr State foldl(integer_range<T, from, to>, State state, F f) {
+    for (T i = from; i < to; ++i)
+        state = f(state, i);
+    return state;
+}
+
+template <typename T, T from, T to, typename Pred>
+constexpr std::size_t count(integer_range<T, from, to>, Pred pred) {
+    std::size_t n = 0;
+    for (T i = from; i < to; ++i)
+        if (pred(i))
+            ++n;
+    return n;
+}
+
+#endif
@@ -2,7 +2,20 @@
 // Distributed under the Boost Software License, Version 1.0.
 
 #include "lambda_tuple.hpp"
+#include "arena.hpp"
 #include <cassert>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+struct counter {
+    static int copies;
+    counter() = default;
+    counter(counter&&) = default;
+    counter(counter const&) { ++copies; }
+};
+int counter::copies = 0;
 
 
 int main() {
@@ -13,6 +26,12 @@ int main() {
     make_tuple();
     make_tuple(1, '2', 3.3);
 
+    // default construction value-initializes the elements
+    {
+        tuple<int, double, std::string> t;
+        assert(get<0>(t) == 0 && get<1>(t) == 0.0 && get<2>(t).empty());
+    }
+
     // get
     assert(get<0>(ts) == 1);
     assert(get<1>(ts) == '2');
@@ -26,7 +45,7 @@ int main() {
 
     // apply
     auto sum = [](auto x, auto y, auto z) { return x + y + z; };
-    assert(apply(sum, make_tuple(1, 2, 3)) == 1 + 2 + 3);
+    assert(::apply(sum, make_tuple(1, 2, 3)) == 1 + 2 + 3);
 
     // tuple_cat
     auto cat = tuple_cat(make_tuple(1, '2'), make_tuple(3.3, nullptr, 5));
@@ -45,9 +64,163 @@ int main() {
         });
     }
 
+    // tuple_foldl and tuple_reduce
+    {
+        auto plus = [](auto x, auto y) { return x + y; };
+        assert(tuple_foldl(make_tuple(), 0, plus) == 0);
+        assert(tuple_foldl(make_tuple(1, 2, 3), 0, plus) == 1 + 2 + 3);
+
+        assert(tuple_reduce(make_tuple(), 0, plus) == 0);
+        assert(tuple_reduce(make_tuple(1), 0, plus) == 1);
+        assert(tuple_reduce(make_tuple(1, 2.5, 3l, 4), 0, plus) == 1 + 2.5 + 3l + 4);
+
+        // The order of the elements is preserved.
+        auto t = make_tuple(std::string{"b"}, std::string{"c"}, std::string{"d"});
+        assert(tuple_reduce(t, std::string{"a"}, plus) == "abcd");
+
+        // Neither the elements nor the intermediate results are copied.
+        auto cs = make_tuple(counter{}, counter{}, counter{}, counter{}, counter{});
+        counter::copies = 0;
+        tuple_reduce(cs, counter{}, [](counter const&, counter const&) {
+            return counter{};
+        });
+        tuple_reduce(cs, counter{}, [](auto&& x, counter const&) -> decltype(auto) {
+            return std::forward<decltype(x)>(x);
+        });
+        assert(counter::copies == 0);
+    }
+
+    // views
+    {
+        auto t = make_tuple(1, '2', 3.3, std::string{"foo"});
+        auto is_floating_point = [](auto const& x) {
+            return std::is_floating_point<std::decay_t<decltype(x)>>{};
+        };
+
+        auto v = slice_c<1, 3>(t);
+        assert(get<0>(v) == '2' && get<1>(v) == 3.3);
+        assert(&get<0>(v) == &get<1>(t));
+        assert(::apply([](auto x, auto y) { return x + y; }, v) == '2' + 3.3);
+
+        auto w = drop_until(t, is_floating_point);
+        assert(get<0>(w) == 3.3 && get<1>(w) == "foo");
+        assert(front(drop_c<1>(w)) == "foo");
+        assert(get<0>(take_until(t, is_floating_point)) == 1);
+        assert(get<1>(take_until(t, is_floating_point)) == '2');
+        auto none = drop_while(t, [](auto const&) { return std::true_type{}; });
+        static_assert(decltype(none.unpack_into)::size == 0, "");
+
+        auto u = tuple_transform(v, [](auto x) { return x + 1; });
+        assert(get<0>(u) == '2' + 1 && get<1>(u) == 3.3 + 1);
+
+        auto m = materialize(w);
+        assert(get<0>(m) == 3.3 && get<1>(m) == "foo");
+        assert(&get<1>(m) != &get<3>(t));
+    }
+
+    // views don't copy the elements until they are materialized
+    {
+        auto t = make_tuple(counter{}, counter{}, counter{}, 1);
+        counter::copies = 0;
+
+        auto v = drop_c<1>(take_c<3>(t));
+        get<0>(v);
+        ::apply([](counter const&, counter const&) { }, v);
+        tuple_for_each(v, [](counter const&) { });
+        tuple_transform(v, [](counter const&) { return 1; });
+        assert(counter::copies == 0);
+
+        // Each element is copied into `make_storage`, and then into the
+        // closure.
+        materialize(v);
+        assert(counter::copies == 4);
+    }
+
+    // tuple_transform_view
+    {
+        auto t = make_tuple(counter{}, counter{}, 1);
+        counter::copies = 0;
+        int calls = 0;
+
+        auto f = [&](auto const&) { ++calls; return 1; };
+        auto g = [&](int x) { ++calls; return x + 1; };
+        auto v = tuple_transform_view(tuple_transform_view(t, f), g);
+        assert(calls == 0);
+
+        assert(::apply([](int x, int y, int z) { return x + y + z; }, v) == 6);
+        assert(calls == 6);
+
+        // `f` and `g` are only applied to the requested element.
+        calls = 0;
+        assert(get<2>(v) == 2);
+        assert(front(v) == 2);
+        assert(calls == 4);
+        tuple_for_each(v, [](int x) { assert(x == 2); });
+        assert(counter::copies == 0);
+
+        auto m = materialize(tuple_transform_view(drop_c<2>(t), g));
+        assert(get<0>(m) == 2);
+
+        // Slicing a transform view doesn't refer to the results of `f`, which
+        // are temporaries; `f` is applied to the sliced elements instead.
+        auto u = make_tuple(std::string{"a"}, std::string{"b"}, std::string{"c"});
+        auto twice = [](std::string const& x) { return x + x; };
+        auto s = slice_c<1, 3>(tuple_transform_view(u, twice));
+        assert(get<0>(s) == "bb" && get<1>(s) == "cc");
+        static_assert(std::is_same<decltype(get<0>(s)), std::string>::value, "");
+        assert(front(drop_c<2>(tuple_transform_view(u, twice))) == "cc");
+        assert(get<0>(take_c<1>(tuple_transform_view(u, twice))) == "aa");
+
+        calls = 0;
+        auto w = drop_until(v, [](int) { return std::true_type{}; });
+        assert(get<0>(take_c<1>(drop_c<1>(w))) == 2);
+        assert(calls == 2);
+    }
+
     // front
     {
         auto t = make_tuple(1, '2', 3.3);
         assert(front(t) == 1);
     }
+
+    // the closure storage can't be assigned to, even when the elements can
+    {
+        using T = tuple<int, float>;
+        static_assert(std::is_copy_constructible<T>::value, "");
+        static_assert(!std::is_copy_assignable<T>::value, "");
+        static_assert(!std::is_move_assignable<T>::value, "");
+        static_assert(!std::is_trivially_copy_assignable<T>::value, "");
+    }
+
+    // copy
+    {
+        auto t = make_tuple(std::string{"foo"}, 1);
+        auto u = t; // copy from a non-const lvalue
+        assert(get<0>(u) == "foo" && get<1>(u) == 1);
+    }
+
+    // uses-allocator construction, also of the nested tuples
+    {
+        monotonic_arena arena;
+        arena_allocator<char> a(arena);
+
+        monotonic_arena other;
+        tuple<arena_vector<int>, arena_string> inner(
+            std::allocator_arg, arena_allocator<char>(other), std::size_t{3}, "bar"
+        );
+        assert(get<1>(inner).get_allocator() != a);
+
+        tuple<arena_string, int, tuple<arena_vector<int>, arena_string>> t(
+            std::allocator_arg, a, "foo", 1, inner
+        );
+        assert(get<0>(t) == "foo" && get<0>(t).get_allocator() == a);
+        assert(get<1>(t) == 1);
+        assert(get<0>(get<2>(t)).size() == 3);
+        assert(get<0>(get<2>(t)).get_allocator() == a);
+        assert(get<1>(get<2>(t)) == "bar" && get<1>(get<2>(t)).get_allocator() == a);
+
+        auto u = allocate_tuple<arena_string, arena_vector<int>>(a);
+        assert(get<0>(u).empty() && get<0>(u).get_allocator() == a);
+        assert(get<1>(u).empty() && get<1>(u).get_allocator() == a);
+    }
 }
@@ -4,7 +4,10 @@
 #ifndef LAMBDA_TUPLE_HPP
 #define LAMBDA_TUPLE_HPP
 
+#include "uses_allocator.hpp"
+
 #include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -12,6 +15,10 @@
 //////////////////////////////////////////////////////////////////////////////
 // std::tuple and std::make_tuple
 //////////////////////////////////////////////////////////////////////////////
+// The elements are captured in a closure, whose copy assignment operator is
+// deleted, so this tuple can't be assigned to. Whether the closure is
+// trivially copyable is left to the implementation. Hence, this backend does
+// not preserve the triviality of its elements; ebo_tuple.hpp does.
 template <typename ...T>
 /* constexpr */ decltype(auto) make_storage(T ...t) {
     // Should move-capture with `t{std::move(t)}...`, but this
@@ -26,116 +33,47 @@ struct tuple {
     using Storage = decltype(make_storage(std::declval<T>()...));
     Storage unpack_into;
 
-    template <typename ...U>
+    // The elements are value-initialized, like those of `std::tuple`.
+    tuple()
+        : unpack_into(make_storage(T()...))
+    { }
+
+    // Without the last condition, this would be selected over the copy
+    // constructor when copying from a non-const lvalue.
+    template <typename ...U, typename = std::enable_if_t<
+        sizeof...(U) == sizeof...(T) && (sizeof...(U) > 0) &&
+        !is_same_tuple<tuple, U...>::value &&
+        !starts_with_allocator_arg<U...>::value
+    >>
     /* constexpr */ explicit tuple(U&& ...u)
         : unpack_into(make_storage(std::forward<U>(u)...))
-    { };
-};
-
-template <typename ...T>
-/* constexpr */ tuple<std::decay_t<T>...> make_tuple(T&& ...t) {
-    return tuple<std::decay_t<T>...>{std::forward<T>(t)...};
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// std::get
-//////////////////////////////////////////////////////////////////////////////
-struct eat { template <typename ...X> constexpr eat(X&& ...) { } };
-
-template <std::size_t n, typename = std::make_index_sequence<n>>
-struct get_impl;
-
-template <std::size_t n, std::size_t ...ignore>
-struct get_impl<n, std::index_sequence<ignore...>> {
-    template <typename Nth, typename ...Rest>
-    constexpr decltype(auto) operator()
-    (decltype(ignore, eat{})..., Nth&& nth, Rest&& ...) const
-    { return std::forward<Nth>(nth); }
+    { }
+
+    // Like `std::tuple`, the elements are constructed with the allocator
+    // given after `std::allocator_arg` whenever they use one.
+    template <typename Alloc>
+    tuple(std::allocator_arg_t, Alloc const& a)
+        : unpack_into(make_storage(make_using_allocator<T>(a)...))
+    { }
+
+    template <typename Alloc, typename ...U, typename = std::enable_if_t<
+        sizeof...(U) == sizeof...(T) && (sizeof...(U) > 0) &&
+        !is_same_tuple<tuple, U...>::value
+    >>
+    tuple(std::allocator_arg_t, Alloc const& a, U&& ...u)
+        : unpack_into(make_storage(make_using_allocator<T>(a, std::forward<U>(u))...))
+    { }
+
+    // Since the elements can only be accessed as const, the elements are
+    // copied with the new allocator even when `other` is an rvalue.
+    template <typename Alloc>
+    tuple(std::allocator_arg_t, Alloc const& a, tuple const& other)
+        : unpack_into(other.unpack_into([&a](auto const& ...x) {
+            return make_storage(make_using_allocator<T>(a, x)...);
+        }))
+    { }
 };
 
-template <std::size_t n, typename Tuple>
-/* constexpr */ decltype(auto) get(Tuple&& ts) {
-    return std::forward<Tuple>(ts).unpack_into(get_impl<n>{});
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// std::tuple_cat
-//////////////////////////////////////////////////////////////////////////////
-template <typename T1, typename T2, typename ...Ts>
-/* constexpr */ decltype(auto) tuple_cat(T1&& t1, T2&& t2, Ts&& ...ts) {
-    return tuple_cat(
-        tuple_cat(std::forward<T1>(t1), std::forward<T2>(t2)),
-        std::forward<Ts>(ts)...
-    );
-}
-
-template <typename Tuple>
-/* constexpr */ decltype(auto) tuple_cat(Tuple&& ts) {
-    return std::forward<Tuple>(ts);
-}
-
-/* constexpr */ decltype(auto) tuple_cat() {
-    return make_tuple();
-}
-
-template <typename Xs, typename Ys>
-/* constexpr */ decltype(auto) tuple_cat(Xs&& xs, Ys&& ys) {
-    return std::forward<Xs>(xs).unpack_into([&ys](auto&& ...x) -> decltype(auto) {
-        return std::forward<Ys>(ys).unpack_into([&](auto&& ...y) -> decltype(auto) {
-            // Should allow perfect forwarding here, but it's unclear how that
-            // could be implemented.
-            return make_tuple(
-                x...,
-                std::forward<decltype(y)>(y)...
-            );
-        });
-    });
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// the proposed C++17 std::apply function
-//////////////////////////////////////////////////////////////////////////////
-template <typename F, typename Tuple>
-/* constexpr */ decltype(auto) apply(F&& f, Tuple&& ts) {
-    return std::forward<Tuple>(ts).unpack_into(std::forward<F>(f));
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// hypothetical std::tuple_transform
-//////////////////////////////////////////////////////////////////////////////
-template <typename Tuple, typename F>
-/* constexpr */ decltype(auto) tuple_transform(Tuple&& ts, F&& f) {
-    return std::forward<Tuple>(ts).unpack_into(
-        [f(std::forward<F>(f))](auto&& ...ts) -> decltype(auto) {
-            return make_tuple(f(std::forward<decltype(ts)>(ts))...);
-        }
-    );
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// hypothetical `std::tuple_for_each`
-//////////////////////////////////////////////////////////////////////////////
-template <typename Tuple, typename F>
-/* constexpr */ void tuple_for_each(Tuple&& ts, F&& f) {
-    std::forward<Tuple>(ts).unpack_into(
-        [&](auto&& ...ts) {
-            using swallow = int[];
-            (void)swallow{1,
-                (f(std::forward<decltype(ts)>(ts)), void(), 1)...
-            };
-        }
-    );
-}
-
-//////////////////////////////////////////////////////////////////////////////
-// front
-//////////////////////////////////////////////////////////////////////////////
-template <typename Tuple>
-/* constexpr */ decltype(auto) front(Tuple&& ts) {
-    auto fst = [](auto&& x, auto&& ...xs) -> decltype(auto) {
-        return std::forward<decltype(x)>(x);
-    };
-    return std::forward<Tuple>(ts).unpack_into(fst);
-}
+#include "tuple_algorithms.hpp"
 
 #endif
@@ -0,0 +1,66 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "segmented_collection.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+struct circle { double radius; };
+struct square { double side; };
+
+double area(circle c) { return 3 * c.radius * c.radius; }
+double area(square s) { return s.side * s.side; }
+
+int main() {
+    // insert, emplace and segment
+    {
+        segmented_collection<circle, square, std::string> shapes;
+        assert(shapes.empty());
+
+        shapes.insert(circle{1});
+        shapes.insert(square{2});
+        shapes.insert(circle{3});
+        std::string& s = shapes.emplace<std::string>(3, 'x');
+        assert(s == "xxx");
+
+        assert(shapes.size() == 4);
+        assert(shapes.segment<circle>().size() == 2);
+        assert(shapes.segment<circle>()[1].radius == 3);
+        assert(shapes.segment<square>().size() == 1);
+        static_assert(std::is_same<
+            decltype(shapes.segment<square>()), std::vector<square>&
+        >::value, "");
+
+        shapes.clear();
+        assert(shapes.empty());
+    }
+
+    // for_each calls the function with the static type of each object
+    {
+        segmented_collection<circle, square> shapes;
+        shapes.insert(square{2});
+        shapes.insert(circle{1});
+        shapes.insert(square{3});
+
+        double total = 0;
+        shapes.for_each([&](auto const& shape) { total += area(shape); });
+        assert(total == 3 + 4 + 9);
+
+        shapes.for_each([](auto& shape) {
+            shape = std::decay_t<decltype(shape)>{1};
+        });
+        segmented_collection<circle, square> const& cshapes = shapes;
+        total = 0;
+        cshapes.for_each([&](auto const& shape) { total += area(shape); });
+        assert(total == 3 + 1 + 1);
+
+        std::size_t segments = 0;
+        cshapes.for_each_segment([&](auto const&) { ++segments; });
+        assert(segments == 2);
+    }
+}
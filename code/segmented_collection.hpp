@@ -0,0 +1,93 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef SEGMENTED_COLLECTION_HPP
+#define SEGMENTED_COLLECTION_HPP
+
+#include "std_tuple.hpp"
+#include "type_list.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// segmented_collection
+//////////////////////////////////////////////////////////////////////////////
+// A collection of objects of the distinct types `T...`, which stores the
+// objects of each type contiguously in their own `std::vector`. This is an
+// alternative to `std::vector<std::unique_ptr<Base>>` when the set of types
+// is known at compile-time: `for_each` visits the segments one after the
+// other, so the function is called with the static type of the objects and
+// no virtual call is required.
+//
+// The objects of a same type are visited in insertion order, but the order
+// between objects of different types is not preserved.
+template <typename ...T>
+class segmented_collection {
+    using Segments = unpack_list_t<tuple,
+        transform_template_t<std::vector, type_list<T...>>
+    >;
+    using Indexer = indexer<std::index_sequence_for<T...>, T...>;
+    Segments segments_;
+
+public:
+    template <typename U>
+    std::vector<U>& segment()
+    { return get<index_of<U, Indexer>::value>(segments_); }
+
+    template <typename U>
+    std::vector<U> const& segment() const
+    { return get<index_of<U, Indexer>::value>(segments_); }
+
+    template <typename U>
+    void insert(U&& u)
+    { segment<std::decay_t<U>>().push_back(std::forward<U>(u)); }
+
+    template <typename U, typename ...Args>
+    U& emplace(Args&& ...args) {
+        segment<U>().emplace_back(std::forward<Args>(args)...);
+        return segment<U>().back();
+    }
+
+    std::size_t size() const {
+        std::size_t n = 0;
+        tuple_for_each(segments_, [&n](auto const& s) { n += s.size(); });
+        return n;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    void clear()
+    { tuple_for_each(segments_, [](auto& s) { s.clear(); }); }
+
+    template <typename F>
+    void for_each(F&& f) {
+        tuple_for_each(segments_, [&f](auto& s) {
+            for (auto& x : s)
+                f(x);
+        });
+    }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        tuple_for_each(segments_, [&f](auto const& s) {
+            for (auto const& x : s)
+                f(x);
+        });
+    }
+
+    // Calls `f` once with each segment, e.g. to process a whole segment with
+    // a single function.
+    template <typename F>
+    void for_each_segment(F&& f)
+    { tuple_for_each(segments_, [&f](auto& s) { f(s); }); }
+
+    template <typename F>
+    void for_each_segment(F&& f) const
+    { tuple_for_each(segments_, [&f](auto const& s) { f(s); }); }
+};
+
+#endif
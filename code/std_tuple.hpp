@@ -4,8 +4,11 @@
 #ifndef STD_TUPLE_HPP
 #define STD_TUPLE_HPP
 
+#include "uses_allocator.hpp"
+
 #include <cstddef>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 
@@ -15,6 +18,24 @@
 using std::tuple;
 using std::make_tuple;
 
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical std::allocate_tuple
+//////////////////////////////////////////////////////////////////////////////
+// Creates a tuple whose elements are constructed from `u...` with the given
+// allocator, using uses-allocator construction. The allocator-extended
+// constructors of `std::tuple` are not used, because they require each
+// element to be constructible without the allocator too, which is not the
+// case of the types that must be given an allocator.
+template <typename ...T, typename Alloc>
+tuple<T...> allocate_tuple(Alloc const& a) {
+    return tuple<T...>(make_using_allocator<T>(a)...);
+}
+
+template <typename ...T, typename Alloc, typename ...U>
+tuple<T...> allocate_tuple(Alloc const& a, U&& ...u) {
+    return tuple<T...>(make_using_allocator<T>(a, std::forward<U>(u))...);
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // std::get
 //////////////////////////////////////////////////////////////////////////////
@@ -30,6 +51,7 @@ using std::tuple_cat;
 //////////////////////////////////////////////////////////////////////////////
 template <typename Tuple, typename F, std::size_t ...i>
 constexpr decltype(auto) tuple_transform_impl(Tuple&& ts, F f, std::index_sequence<i...>) {
+    (void)f; // unused when the tuple is empty
     return make_tuple(f(get<i>(std::forward<Tuple>(ts)))...);
 }
 
@@ -44,11 +66,51 @@ constexpr decltype(auto) tuple_transform(Tuple&& ts, F&& f) {
     );
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// lazy tuple_transform
+//////////////////////////////////////////////////////////////////////////////
+// Unlike `tuple_transform`, this does not create a new tuple. Instead, `get`
+// applies `f` to the corresponding element of the underlying tuple, so that
+// chaining several of these views composes the functions without creating
+// any intermediate tuple. The view holds a reference to the underlying
+// tuple, which must outlive it; views of other views hold them by value.
+template <typename Tuple, typename F>
+struct transform_view {
+    Tuple tuple;
+    F f;
+};
+
+namespace std {
+    template <typename Tuple, typename F>
+    struct tuple_size<::transform_view<Tuple, F>>
+        : tuple_size<std::decay_t<Tuple>>
+    { };
+}
+
+template <std::size_t n, typename Tuple, typename F>
+constexpr decltype(auto) get(transform_view<Tuple, F> const& view) {
+    return view.f(get<n>(view.tuple));
+}
+
+template <typename ...T, typename F>
+constexpr auto tuple_transform_view(std::tuple<T...> const& ts, F f) {
+    return transform_view<std::tuple<T...> const&, F>{ts, f};
+}
+
+template <typename Tuple, typename G, typename F>
+constexpr auto tuple_transform_view(transform_view<Tuple, G> const& ts, F f) {
+    return transform_view<transform_view<Tuple, G>, F>{ts, f};
+}
+
+template <typename ...T, typename F>
+void tuple_transform_view(std::tuple<T...> const&&, F) = delete;
+
 //////////////////////////////////////////////////////////////////////////////
 // hypothetical `std::tuple_for_each`
 //////////////////////////////////////////////////////////////////////////////
 template <typename Tuple, typename F, std::size_t ...i>
 constexpr void tuple_for_each_impl(Tuple&& ts, F f, std::index_sequence<i...>) {
+    (void)f; // unused when the tuple is empty
     using swallow = int[];
     (void)swallow{1,
         (f(get<i>(std::forward<Tuple>(ts))), void(), 1)...
@@ -85,4 +147,70 @@ constexpr decltype(auto) apply(F&& f, Tuple&& ts) {
     );
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical `std::tuple_foldl` and `std::tuple_reduce`
+//////////////////////////////////////////////////////////////////////////////
+// `tuple_reduce` requires `f` to be associative, and applies it in a balanced
+// tree. Each level refers to its arguments with `std::forward_as_tuple`, and
+// passes its results to the next level as arguments, so that no element is
+// ever copied into an intermediate tuple.
+template <typename F, typename State>
+constexpr auto foldl_impl(F&, State&& state) {
+    return std::forward<State>(state);
+}
+
+template <typename F, typename State, typename X, typename ...Xs>
+constexpr auto foldl_impl(F& f, State&& state, X&& x, Xs&& ...xs) {
+    return foldl_impl(f,
+        f(std::forward<State>(state), std::forward<X>(x)),
+        std::forward<Xs>(xs)...
+    );
+}
+
+template <typename Tuple, typename State, typename F>
+constexpr auto tuple_foldl(Tuple&& ts, State&& state, F&& f) {
+    return ::apply([&](auto&& ...xs) {
+        return foldl_impl(f, std::forward<State>(state),
+                             std::forward<decltype(xs)>(xs)...);
+    }, std::forward<Tuple>(ts));
+}
+
+template <typename F, typename X>
+constexpr auto reduce_impl(F&, X&& x) {
+    return std::forward<X>(x);
+}
+
+template <typename F, typename X1, typename X2, typename ...Xs>
+constexpr auto reduce_impl(F& f, X1&& x1, X2&& x2, Xs&& ...xs);
+
+template <typename F, typename Refs, std::size_t ...i, std::size_t ...last>
+constexpr auto reduce_pairs(F& f, Refs&& refs, std::index_sequence<i...>,
+                                               std::index_sequence<last...>)
+{
+    return reduce_impl(f, f(get<2*i>(std::move(refs)),
+                            get<2*i+1>(std::move(refs)))...,
+                          get<last>(std::move(refs))...);
+}
+
+template <typename F, typename X1, typename X2, typename ...Xs>
+constexpr auto reduce_impl(F& f, X1&& x1, X2&& x2, Xs&& ...xs) {
+    constexpr std::size_t n = 2 + sizeof...(Xs);
+    return reduce_pairs(f,
+        std::forward_as_tuple(std::forward<X1>(x1), std::forward<X2>(x2),
+                              std::forward<Xs>(xs)...),
+        std::make_index_sequence<n / 2>{},
+        std::conditional_t<n % 2 == 1,
+            std::index_sequence<n - 1>, std::index_sequence<>
+        >{}
+    );
+}
+
+template <typename Tuple, typename State, typename F>
+constexpr auto tuple_reduce(Tuple&& ts, State&& state, F&& f) {
+    return ::apply([&](auto&& ...xs) {
+        return reduce_impl(f, std::forward<State>(state),
+                              std::forward<decltype(xs)>(xs)...);
+    }, std::forward<Tuple>(ts));
+}
+
 #endif
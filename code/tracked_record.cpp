@@ -0,0 +1,106 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "tracked_record.hpp"
+
+#include <cassert>
+#include <string>
+
+
+struct Person {
+    std::string name;
+    int age;
+    double height;
+};
+
+using Name = RECORD_MEMBER(Person, name);
+using Age = RECORD_MEMBER(Person, age);
+using Height = RECORD_MEMBER(Person, height);
+using TrackedPerson = tracked<Person, Name, Age, Height>;
+
+int main() {
+    // accessors mark the members as modified
+    {
+        TrackedPerson p{Person{"Louis", 22, 1.8}};
+        assert(!p.is_dirty());
+        assert(p.get<Name>() == "Louis");
+
+        p.set<Age>(23);
+        assert(p.is_dirty());
+        assert(p.is_dirty<Age>());
+        assert(!p.is_dirty<Name>());
+        assert(p.record().age == 23);
+
+        p.modify<Name>() += " D.";
+        assert(p.is_dirty<Name>());
+        assert(p.get<Name>() == "Louis D.");
+
+        p.clear();
+        assert(!p.is_dirty());
+    }
+
+    // deltas only contain the modified members
+    {
+        TrackedPerson sender{Person{"Louis", 22, 1.8}};
+        TrackedPerson receiver;
+
+        std::string full;
+        sender.encode_full(full);
+        receiver.apply_delta(full);
+        assert(receiver.get<Name>() == "Louis");
+        assert(receiver.get<Age>() == 22);
+        assert(receiver.get<Height>() == 1.8);
+        assert(!receiver.is_dirty());
+
+        sender.set<Age>(23);
+        std::string delta;
+        sender.encode_delta(delta);
+        assert(delta.size() == 1 + sizeof(int));
+        receiver.apply_delta(delta);
+        assert(receiver.get<Age>() == 23);
+        assert(receiver.get<Name>() == "Louis");
+
+        sender.clear();
+        std::string empty;
+        sender.encode_delta(empty);
+        assert(empty.size() == 1);
+        receiver.apply_delta(empty);
+        assert(receiver.get<Age>() == 23);
+    }
+
+    // malformed deltas are rejected
+    {
+        TrackedPerson sender{Person{"Louis", 22, 1.8}};
+        TrackedPerson receiver{Person{"Ada", 36, 1.7}};
+        std::string full;
+        sender.encode_full(full);
+
+        bool thrown = false;
+        try { receiver.apply_delta(full.substr(0, full.size() - 1)); }
+        catch (bad_delta const&) { thrown = true; }
+        assert(thrown);
+
+        thrown = false;
+        try { receiver.apply_delta(full + 'x'); }
+        catch (bad_delta const&) { thrown = true; }
+        assert(thrown);
+
+        // a bit set past the last member
+        thrown = false;
+        std::string unused_bit = full;
+        unused_bit[0] |= 1 << 3;
+        try { receiver.apply_delta(unused_bit); }
+        catch (bad_delta const&) { thrown = true; }
+        assert(thrown);
+
+        thrown = false;
+        try { receiver.apply_delta(std::string{}); }
+        catch (bad_delta const&) { thrown = true; }
+        assert(thrown);
+
+        // the receiver is left unchanged
+        assert(receiver.get<Name>() == "Ada");
+        assert(receiver.get<Age>() == 36);
+        assert(receiver.get<Height>() == 1.7);
+    }
+}
@@ -0,0 +1,270 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef TRACKED_RECORD_HPP
+#define TRACKED_RECORD_HPP
+
+#include "type_list.hpp"
+#include "uses_allocator.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Field encoding
+//////////////////////////////////////////////////////////////////////////////
+// Fields are appended to a `std::string` used as a byte buffer. Arithmetic
+// types are copied as is, in the native byte order, and strings are prefixed
+// by their size as a native `std::uint32_t`. Hence, deltas can only be
+// exchanged between machines with the same byte order and the same sizes of
+// arithmetic types. Other types can be supported by providing `encode_field`
+// and `decode_field` overloads which can be found by ADL.
+struct bad_delta : std::exception {
+    char const* what() const noexcept override
+    { return "bad_delta"; }
+};
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+void encode_field(std::string& out, T const& x) {
+    out.append(reinterpret_cast<char const*>(&x), sizeof x);
+}
+
+template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+void decode_field(char const*& first, char const* last, T& x) {
+    if (static_cast<std::size_t>(last - first) < sizeof x)
+        throw bad_delta{};
+    std::memcpy(&x, first, sizeof x);
+    first += sizeof x;
+}
+
+inline void encode_field(std::string& out, std::string const& s) {
+    encode_field(out, static_cast<std::uint32_t>(s.size()));
+    out += s;
+}
+
+inline void decode_field(char const*& first, char const* last, std::string& s) {
+    std::uint32_t size;
+    decode_field(first, last, size);
+    if (static_cast<std::size_t>(last - first) < size)
+        throw bad_delta{};
+    s.assign(first, size);
+    first += size;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// record_member
+//////////////////////////////////////////////////////////////////////////////
+// Describes a data member of a record at compile-time. The members are not
+// taken from the accessors generated by `BOOST_HANA_DEFINE_RECORD_INTRUSIVE`;
+// the records defined with it, like `Person` in record.cpp, have ordinary
+// data members which are listed by hand instead:
+//
+//  using Name = RECORD_MEMBER(Person, name);
+template <typename Pointer, Pointer p>
+struct record_member;
+
+template <typename Record, typename T, T Record::*p>
+struct record_member<T Record::*, p> {
+    using type = T;
+    static T& get(Record& r) { return r.*p; }
+    static T const& get(Record const& r) { return r.*p; }
+};
+
+#define RECORD_MEMBER(Record, name) \
+    ::record_member<decltype(&Record::name), &Record::name>
+
+//////////////////////////////////////////////////////////////////////////////
+// make_record_using_allocator
+//////////////////////////////////////////////////////////////////////////////
+// Creates a record whose members are constructed from `args...` with the
+// given allocator, using uses-allocator construction, so that an arena given
+// once reaches every allocator-aware member. The record is aggregate
+// initialized, so `Members` must describe all of its data members in the
+// order of their declaration. Only aggregates whose members are described by
+// hand are supported; the members of the records defined with
+// `BOOST_HANA_DEFINE_RECORD_INTRUSIVE` must be listed with `RECORD_MEMBER`
+// too. Without `args...`, the members are default constructed with the
+// allocator.
+//
+// A record missing some of the `Members` is caught by comparing its size
+// with the size of a struct made of the `Members` only, unless the missing
+// members fit in the padding.
+template <typename ...T>
+constexpr std::size_t aggregate_size() {
+    std::size_t const sizes[] = {sizeof(T)..., 0};
+    std::size_t const aligns[] = {alignof(T)..., 1};
+    std::size_t size = 0, align = 1;
+    for (std::size_t i = 0; i < sizeof...(T); ++i) {
+        size = (size + aligns[i] - 1) / aligns[i] * aligns[i] + sizes[i];
+        align = aligns[i] > align ? aligns[i] : align;
+    }
+    size = (size + align - 1) / align * align;
+    return size == 0 ? 1 : size;
+}
+
+template <typename Record, typename ...Members>
+struct covers_record : std::integral_constant<bool,
+    sizeof(Record) == aggregate_size<typename Members::type...>()
+> { };
+
+template <typename Record, typename ...Members, typename Alloc>
+Record make_record_using_allocator(Alloc const& a) {
+    static_assert(covers_record<Record, Members...>::value,
+        "make_record_using_allocator requires Members to describe all the data members of Record");
+    return Record{make_using_allocator<typename Members::type>(a)...};
+}
+
+template <typename Record, typename ...Members, typename Alloc, typename ...Args>
+Record make_record_using_allocator(Alloc const& a, Args&& ...args) {
+    static_assert(covers_record<Record, Members...>::value,
+        "make_record_using_allocator requires Members to describe all the data members of Record");
+    static_assert(sizeof...(Members) == sizeof...(Args),
+        "make_record_using_allocator requires one argument per member");
+    return Record{
+        make_using_allocator<typename Members::type>(a, std::forward<Args>(args))...
+    };
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// tracked
+//////////////////////////////////////////////////////////////////////////////
+// Wraps a record and remembers which of the given `Members` were modified
+// through its accessors, in a bitmask whose size is known at compile-time.
+//
+// `encode_delta` appends the bitmask followed by the modified members only,
+// and `apply_delta` applies such an encoding to another record. Encoding and
+// applying deltas visit the members in a single pack expansion.
+template <typename Record, typename ...Members>
+class tracked {
+    static_assert(sizeof...(Members) > 0, "a tracked record must have at least one member");
+
+    using Indexer = indexer<std::index_sequence_for<Members...>, Members...>;
+    using Indices = std::index_sequence_for<Members...>;
+    static constexpr std::size_t mask_bytes = (sizeof...(Members) + 7) / 8;
+
+    Record record_;
+    std::bitset<sizeof...(Members)> dirty_;
+
+    template <typename Member>
+    using index = index_of<Member, Indexer>;
+
+    template <std::size_t ...i>
+    void encode_members(std::string& out,
+                        std::bitset<sizeof...(Members)> const& mask,
+                        std::index_sequence<i...>) const
+    {
+        int expand[] = {0, (mask[i] ? encode_field(out, Members::get(record_)) : void(), 0)...};
+        (void)expand;
+    }
+
+    template <std::size_t ...i>
+    static void decode_members(char const*& first, char const* last,
+                               std::bitset<sizeof...(Members)> const& mask,
+                               std::tuple<typename Members::type...>& fields,
+                               std::index_sequence<i...>)
+    {
+        int expand[] = {0, (mask[i] ? decode_field(first, last, std::get<i>(fields)) : void(), 0)...};
+        (void)expand;
+    }
+
+    template <std::size_t ...i>
+    void assign_members(std::bitset<sizeof...(Members)> const& mask,
+                        std::tuple<typename Members::type...>& fields,
+                        std::index_sequence<i...>)
+    {
+        int expand[] = {0, (mask[i] ? void(Members::get(record_) = std::move(std::get<i>(fields))) : void(), 0)...};
+        (void)expand;
+    }
+
+    void encode(std::string& out, std::bitset<sizeof...(Members)> const& mask) const {
+        char bytes[mask_bytes] = {};
+        for (std::size_t i = 0; i < sizeof...(Members); ++i)
+            if (mask[i])
+                bytes[i / 8] |= static_cast<char>(1 << (i % 8));
+        out.append(bytes, mask_bytes);
+    }
+
+public:
+    tracked() = default;
+
+    explicit tracked(Record record) : record_(std::move(record)) { }
+
+    Record const& record() const { return record_; }
+
+    template <typename Member>
+    typename Member::type const& get() const { return Member::get(record_); }
+
+    template <typename Member, typename U>
+    void set(U&& u) {
+        Member::get(record_) = std::forward<U>(u);
+        dirty_.set(index<Member>::value);
+    }
+
+    // Returns a reference to the member and marks it as modified, whether
+    // it is actually modified or not.
+    template <typename Member>
+    typename Member::type& modify() {
+        dirty_.set(index<Member>::value);
+        return Member::get(record_);
+    }
+
+    template <typename Member>
+    bool is_dirty() const { return dirty_[index<Member>::value]; }
+
+    bool is_dirty() const { return dirty_.any(); }
+
+    void clear() { dirty_.reset(); }
+
+    // Appends the members modified since the last call to `clear`.
+    void encode_delta(std::string& out) const {
+        encode(out, dirty_);
+        encode_members(out, dirty_, Indices{});
+    }
+
+    // Appends all the members, in the same format as `encode_delta`.
+    void encode_full(std::string& out) const {
+        auto all = std::bitset<sizeof...(Members)>{}.set();
+        encode(out, all);
+        encode_members(out, all, Indices{});
+    }
+
+    // Assigns the members contained in an encoding produced by `encode_delta`
+    // or `encode_full`. The assigned members are not marked as modified,
+    // and `bad_delta` is thrown if the encoding is truncated, too long, or
+    // if its bitmask has bits set past the last member. The members are
+    // decoded into temporaries and only assigned once the whole encoding is
+    // accepted, so the record is left unchanged when it is rejected.
+    void apply_delta(std::string const& delta) {
+        char const* first = delta.data();
+        char const* last = first + delta.size();
+        if (delta.size() < mask_bytes)
+            throw bad_delta{};
+
+        std::bitset<sizeof...(Members)> mask;
+        for (std::size_t i = 0; i < sizeof...(Members); ++i)
+            mask[i] = (first[i / 8] >> (i % 8)) & 1;
+        unsigned char unused = static_cast<unsigned char>(first[mask_bytes - 1])
+                                    >> ((sizeof...(Members) - 1) % 8 + 1);
+        if (unused != 0)
+            throw bad_delta{};
+        first += mask_bytes;
+
+        // The temporaries of the members which are not in the delta are
+        // default constructed and left alone.
+        std::tuple<typename Members::type...> fields;
+        decode_members(first, last, mask, fields, Indices{});
+        if (first != last)
+            throw bad_delta{};
+        assign_members(mask, fields, Indices{});
+    }
+};
+
+#endif
@@ -0,0 +1,492 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef TUPLE_ALGORITHMS_HPP
+#define TUPLE_ALGORITHMS_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+// These are the algorithms of the backends which give access to the elements
+// of a tuple through its `unpack_into` member, i.e. lambda_tuple.hpp and
+// ebo_tuple.hpp. They only differ in how the elements are stored, so this
+// header is included by each of them right after `tuple` is defined.
+
+// Makes uses-allocator construction pass the allocator down to the tuples
+// nested in other tuples or in allocator-aware containers.
+namespace std {
+    template <typename ...T, typename Alloc>
+    struct uses_allocator<::tuple<T...>, Alloc> : true_type { };
+}
+
+// `make_tuple` is a function object rather than a function template, so that
+// unqualified calls with arguments from namespace `std` do not also find
+// `std::make_tuple` by argument-dependent lookup, which would make them
+// ambiguous whenever `<tuple>` is included, e.g. by `<memory>`.
+struct make_tuple_t {
+    template <typename ...T>
+    /* constexpr */ tuple<std::decay_t<T>...> operator()(T&& ...t) const {
+        return tuple<std::decay_t<T>...>{std::forward<T>(t)...};
+    }
+};
+
+constexpr make_tuple_t make_tuple{};
+
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical std::allocate_tuple
+//////////////////////////////////////////////////////////////////////////////
+template <typename ...T, typename Alloc, typename ...U>
+tuple<T...> allocate_tuple(Alloc const& a, U&& ...u) {
+    return tuple<T...>(std::allocator_arg, a, std::forward<U>(u)...);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// std::get
+//////////////////////////////////////////////////////////////////////////////
+struct eat { template <typename ...X> constexpr eat(X&& ...) { } };
+
+template <std::size_t n, typename = std::make_index_sequence<n>>
+struct get_impl;
+
+template <std::size_t n, std::size_t ...ignore>
+struct get_impl<n, std::index_sequence<ignore...>> {
+    template <typename Nth, typename ...Rest>
+    constexpr decltype(auto) operator()
+    (decltype(ignore, eat{})..., Nth&& nth, Rest&& ...) const
+    { return std::forward<Nth>(nth); }
+};
+
+template <std::size_t n, typename Tuple>
+/* constexpr */ decltype(auto) get(Tuple&& ts) {
+    return std::forward<Tuple>(ts).unpack_into(get_impl<n>{});
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// indexed references
+//////////////////////////////////////////////////////////////////////////////
+// Unpacking a tuple gives access to all its elements at once, but selecting
+// some of them with `get_impl` would instantiate a function with as many
+// parameters as the tuple for each of them. Instead, the elements are given
+// an index by putting references to them in the bases of an object, so that
+// `get_ref` finds the `k`th one in a single overload resolution.
+template <std::size_t i, typename X>
+struct indexed_ref {
+    X&& ref;
+};
+
+template <typename Indices, typename ...X>
+struct indexed_refs;
+
+template <std::size_t ...i, typename ...X>
+struct indexed_refs<std::index_sequence<i...>, X...> : indexed_ref<i, X>... {
+    explicit constexpr indexed_refs(X&& ...x)
+        : indexed_ref<i, X>{std::forward<X>(x)}...
+    { }
+};
+
+template <std::size_t k, typename X>
+constexpr X&& get_ref(indexed_ref<k, X> const& r) {
+    return std::forward<X>(r.ref);
+}
+
+template <typename ...X>
+constexpr auto make_refs(X&& ...x) {
+    return indexed_refs<std::index_sequence_for<X...>, X...>(std::forward<X>(x)...);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// std::tuple_cat
+//////////////////////////////////////////////////////////////////////////////
+template <typename T1, typename T2, typename ...Ts>
+/* constexpr */ decltype(auto) tuple_cat(T1&& t1, T2&& t2, Ts&& ...ts) {
+    return tuple_cat(
+        tuple_cat(std::forward<T1>(t1), std::forward<T2>(t2)),
+        std::forward<Ts>(ts)...
+    );
+}
+
+template <typename Tuple>
+/* constexpr */ decltype(auto) tuple_cat(Tuple&& ts) {
+    return std::forward<Tuple>(ts);
+}
+
+/* constexpr */ decltype(auto) tuple_cat() {
+    return make_tuple();
+}
+
+template <typename Xs, typename Ys>
+/* constexpr */ decltype(auto) tuple_cat(Xs&& xs, Ys&& ys) {
+    return std::forward<Xs>(xs).unpack_into([&ys](auto&& ...x) -> decltype(auto) {
+        return std::forward<Ys>(ys).unpack_into([&](auto&& ...y) -> decltype(auto) {
+            // Should allow perfect forwarding here, but it's unclear how that
+            // could be implemented.
+            return make_tuple(
+                x...,
+                std::forward<decltype(y)>(y)...
+            );
+        });
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// the proposed C++17 std::apply function
+//////////////////////////////////////////////////////////////////////////////
+template <typename F, typename Tuple>
+/* constexpr */ decltype(auto) apply(F&& f, Tuple&& ts) {
+    return std::forward<Tuple>(ts).unpack_into(std::forward<F>(f));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical std::tuple_transform
+//////////////////////////////////////////////////////////////////////////////
+template <typename Tuple, typename F>
+/* constexpr */ decltype(auto) tuple_transform(Tuple&& ts, F&& f) {
+    return std::forward<Tuple>(ts).unpack_into(
+        [f(std::forward<F>(f))](auto&& ...ts) -> decltype(auto) {
+            return make_tuple(f(std::forward<decltype(ts)>(ts))...);
+        }
+    );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical `std::tuple_for_each`
+//////////////////////////////////////////////////////////////////////////////
+template <typename Tuple, typename F>
+/* constexpr */ void tuple_for_each(Tuple&& ts, F&& f) {
+    std::forward<Tuple>(ts).unpack_into(
+        [&](auto&& ...ts) {
+            using swallow = int[];
+            (void)swallow{1,
+                (f(std::forward<decltype(ts)>(ts)), void(), 1)...
+            };
+        }
+    );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// hypothetical `std::tuple_foldl` and `std::tuple_reduce`
+//////////////////////////////////////////////////////////////////////////////
+// `tuple_reduce` requires `f` to be associative, and applies it in a balanced
+// tree; each level passes its results to the next one as arguments, so they
+// are never copied into an intermediate tuple.
+template <typename F, typename State>
+/* constexpr */ auto foldl_impl(F&, State&& state) {
+    return std::forward<State>(state);
+}
+
+template <typename F, typename State, typename X, typename ...Xs>
+/* constexpr */ auto foldl_impl(F& f, State&& state, X&& x, Xs&& ...xs) {
+    return foldl_impl(f,
+        f(std::forward<State>(state), std::forward<X>(x)),
+        std::forward<Xs>(xs)...
+    );
+}
+
+template <typename Tuple, typename State, typename F>
+/* constexpr */ auto tuple_foldl(Tuple&& ts, State&& state, F&& f) {
+    return std::forward<Tuple>(ts).unpack_into([&](auto&& ...xs) {
+        return foldl_impl(f, std::forward<State>(state),
+                             std::forward<decltype(xs)>(xs)...);
+    });
+}
+
+template <typename F, typename X>
+/* constexpr */ auto reduce_impl(F&, X&& x) {
+    return std::forward<X>(x);
+}
+
+template <typename F, typename X1, typename X2, typename ...Xs>
+/* constexpr */ auto reduce_impl(F& f, X1&& x1, X2&& x2, Xs&& ...xs);
+
+template <typename F, typename Refs, std::size_t ...i, std::size_t ...last>
+/* constexpr */ auto reduce_pairs(F& f, Refs const& r,
+                                  std::index_sequence<i...>,
+                                  std::index_sequence<last...>)
+{
+    return reduce_impl(f, f(get_ref<2*i>(r), get_ref<2*i+1>(r))...,
+                          get_ref<last>(r)...);
+}
+
+template <typename F, typename X1, typename X2, typename ...Xs>
+/* constexpr */ auto reduce_impl(F& f, X1&& x1, X2&& x2, Xs&& ...xs) {
+    constexpr std::size_t n = 2 + sizeof...(Xs);
+    return reduce_pairs(f,
+        make_refs(std::forward<X1>(x1), std::forward<X2>(x2),
+                  std::forward<Xs>(xs)...),
+        std::make_index_sequence<n / 2>{},
+        std::conditional_t<n % 2 == 1,
+            std::index_sequence<n - 1>, std::index_sequence<>
+        >{}
+    );
+}
+
+template <typename Tuple, typename State, typename F>
+/* constexpr */ auto tuple_reduce(Tuple&& ts, State&& state, F&& f) {
+    return std::forward<Tuple>(ts).unpack_into([&](auto&& ...xs) {
+        return reduce_impl(f, std::forward<State>(state),
+                              std::forward<decltype(xs)>(xs)...);
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// front
+//////////////////////////////////////////////////////////////////////////////
+template <typename Tuple>
+/* constexpr */ decltype(auto) front(Tuple&& ts) {
+    return get<0>(std::forward<Tuple>(ts));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// views
+//////////////////////////////////////////////////////////////////////////////
+// A view refers to some elements of a tuple without copying them. Since all
+// the functions above only access a tuple through its `unpack_into` member,
+// they also work on views, and they see the referenced elements. The viewed
+// tuple must outlive the view; this is why views can't be created from
+// temporary tuples.
+template <typename Refs, std::size_t ...i>
+struct view_storage {
+    static constexpr std::size_t size = sizeof...(i);
+    Refs refs;
+
+    template <typename F>
+    constexpr decltype(auto) operator()(F&& f) const {
+        return std::forward<F>(f)(get_ref<i>(refs)...);
+    }
+};
+
+template <typename Refs, std::size_t ...i>
+struct tuple_view {
+    view_storage<Refs, i...> unpack_into;
+};
+
+template <std::size_t ...i, typename ...X>
+constexpr auto as_view_storage(indexed_refs<std::index_sequence<i...>, X...> const& r) {
+    return view_storage<indexed_refs<std::index_sequence<i...>, X...>, i...>{r};
+}
+
+template <typename Storage>
+constexpr auto as_view_storage(Storage const& s) {
+    return as_view_storage(s([](auto const& ...xs) {
+        return make_refs(xs...);
+    }));
+}
+
+template <typename Refs, std::size_t ...i>
+constexpr auto as_view_storage(view_storage<Refs, i...> const& s) {
+    return s;
+}
+
+template <std::size_t k, std::size_t ...i>
+constexpr std::size_t nth_index() {
+    constexpr std::size_t is[] = {i..., 0};
+    return is[k];
+}
+
+// Creates a view of the elements `from`, `from + 1`, ... of the given view.
+template <std::size_t from, typename Refs, std::size_t ...i, std::size_t ...k>
+constexpr auto make_view(view_storage<Refs, i...> s, std::index_sequence<k...>) {
+    return tuple_view<Refs, nth_index<from + k, i...>()...>{{s.refs}};
+}
+
+template <std::size_t from, std::size_t to, typename Tuple>
+constexpr auto slice_c(Tuple const& ts) {
+    auto s = as_view_storage(ts.unpack_into);
+    static_assert(from <= to && to <= decltype(s)::size, "");
+    return make_view<from>(s, std::make_index_sequence<to - from>{});
+}
+
+template <std::size_t n, typename Tuple>
+constexpr auto drop_c(Tuple const& ts) {
+    return slice_c<n, decltype(as_view_storage(ts.unpack_into))::size>(ts);
+}
+
+template <std::size_t n, typename Tuple>
+constexpr auto take_c(Tuple const& ts) {
+    return slice_c<0, n>(ts);
+}
+
+template <std::size_t from, std::size_t to, typename ...T>
+void slice_c(tuple<T...> const&&) = delete;
+
+template <std::size_t n, typename ...T>
+void drop_c(tuple<T...> const&&) = delete;
+
+template <std::size_t n, typename ...T>
+void take_c(tuple<T...> const&&) = delete;
+
+// The predicates must return an `std::integral_constant`-like object, so the
+// position at which to cut the tuple is known at compile-time.
+template <bool ...b>
+constexpr std::size_t find_first() {
+    constexpr bool bs[] = {b..., true};
+    std::size_t k = 0;
+    while (!bs[k])
+        ++k;
+    return k;
+}
+
+template <typename Pred, bool expected>
+struct find_index_if {
+    template <typename ...X>
+    constexpr auto operator()(X const& ...) const {
+        return std::integral_constant<std::size_t, find_first<(
+            std::decay_t<decltype(std::declval<Pred>()(std::declval<X const&>()))>::value == expected
+        )...>()>{};
+    }
+};
+
+template <typename Tuple, typename Pred>
+constexpr auto drop_until(Tuple const& ts, Pred const&) {
+    using Index = decltype(ts.unpack_into(find_index_if<Pred, true>{}));
+    return drop_c<Index::value>(ts);
+}
+
+template <typename Tuple, typename Pred>
+constexpr auto drop_while(Tuple const& ts, Pred const&) {
+    using Index = decltype(ts.unpack_into(find_index_if<Pred, false>{}));
+    return drop_c<Index::value>(ts);
+}
+
+template <typename Tuple, typename Pred>
+constexpr auto take_until(Tuple const& ts, Pred const&) {
+    using Index = decltype(ts.unpack_into(find_index_if<Pred, true>{}));
+    return take_c<Index::value>(ts);
+}
+
+template <typename Tuple, typename Pred>
+constexpr auto take_while(Tuple const& ts, Pred const&) {
+    using Index = decltype(ts.unpack_into(find_index_if<Pred, false>{}));
+    return take_c<Index::value>(ts);
+}
+
+template <typename Pred, typename ...T>
+void drop_until(tuple<T...> const&&, Pred const&) = delete;
+
+template <typename Pred, typename ...T>
+void drop_while(tuple<T...> const&&, Pred const&) = delete;
+
+template <typename Pred, typename ...T>
+void take_until(tuple<T...> const&&, Pred const&) = delete;
+
+template <typename Pred, typename ...T>
+void take_while(tuple<T...> const&&, Pred const&) = delete;
+
+// Copies the elements referenced by a view into a new tuple.
+template <typename Tuple>
+/* constexpr */ auto materialize(Tuple const& ts) {
+    return ts.unpack_into([](auto const& ...xs) {
+        return make_tuple(xs...);
+    });
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// lazy tuple_transform
+//////////////////////////////////////////////////////////////////////////////
+// Unlike `tuple_transform`, this does not create a new tuple. Instead, `f` is
+// applied to the elements of the underlying tuple whenever the result is
+// unpacked, and chaining several of these views composes the functions
+// without creating any intermediate tuple. The results of `f` are temporaries,
+// so both unpacking the view and `get` return by value.
+template <typename Source, typename F>
+struct transform_storage {
+    Source source;
+    F f;
+
+    static constexpr std::size_t size = Source::size;
+
+    template <typename G>
+    constexpr auto operator()(G&& g) const {
+        return source([&](auto&& ...xs) {
+            return std::forward<G>(g)(f(std::forward<decltype(xs)>(xs))...);
+        });
+    }
+};
+
+template <typename Source, typename F>
+struct transform_view {
+    transform_storage<Source, F> unpack_into;
+};
+
+// A transform view has no elements to refer to, only the temporaries
+// returned by `f`; see `slice_c` below.
+template <typename Source, typename F>
+void as_view_storage(transform_storage<Source, F> const&) = delete;
+
+template <typename Storage>
+constexpr auto as_transform_source(Storage const& s) {
+    return as_view_storage(s);
+}
+
+template <typename Source, typename F>
+constexpr auto as_transform_source(transform_storage<Source, F> const& s) {
+    return s;
+}
+
+template <typename Tuple, typename F>
+constexpr auto tuple_transform_view(Tuple const& ts, F f) {
+    using Source = decltype(as_transform_source(ts.unpack_into));
+    return transform_view<Source, F>{{as_transform_source(ts.unpack_into), f}};
+}
+
+template <typename F, typename ...T>
+void tuple_transform_view(tuple<T...> const&&, F) = delete;
+
+// Slicing a transform view slices its source instead, so `f` is still applied
+// to the elements of the underlying tuple when the result is unpacked.
+template <std::size_t from, std::size_t to, typename Refs, std::size_t ...i>
+constexpr auto slice_storage(view_storage<Refs, i...> const& s) {
+    return make_view<from>(s, std::make_index_sequence<to - from>{}).unpack_into;
+}
+
+template <std::size_t from, std::size_t to, typename Source, typename F>
+constexpr auto slice_storage(transform_storage<Source, F> const& s) {
+    using Sliced = decltype(slice_storage<from, to>(s.source));
+    return transform_storage<Sliced, F>{slice_storage<from, to>(s.source), s.f};
+}
+
+template <std::size_t from, std::size_t to, typename Source, typename F>
+constexpr auto slice_c(transform_view<Source, F> const& v) {
+    static_assert(from <= to && to <= Source::size, "");
+    using Sliced = decltype(slice_storage<from, to>(v.unpack_into.source));
+    return transform_view<Sliced, F>{slice_storage<from, to>(v.unpack_into)};
+}
+
+template <std::size_t n, typename Source, typename F>
+constexpr auto drop_c(transform_view<Source, F> const& v) {
+    return slice_c<n, Source::size>(v);
+}
+
+// Unpacking the view to get a single element would apply `f` to all of them,
+// so `get` applies the functions to the `n`th element of the source only.
+template <std::size_t n, typename Refs, std::size_t ...i>
+constexpr decltype(auto) get_transformed(view_storage<Refs, i...> const& s) {
+    return get_ref<nth_index<n, i...>()>(s.refs);
+}
+
+template <std::size_t n, typename Source, typename F>
+constexpr auto get_transformed(transform_storage<Source, F> const& s) {
+    return s.f(get_transformed<n>(s.source));
+}
+
+template <std::size_t n, typename Source, typename F>
+constexpr auto get(transform_view<Source, F> const& v) {
+    static_assert(n < Source::size, "");
+    return get_transformed<n>(v.unpack_into);
+}
+
+// These are more specialized than `get(Tuple&&)` for non-const views.
+template <std::size_t n, typename Source, typename F>
+constexpr auto get(transform_view<Source, F>& v) {
+    return get<n>(static_cast<transform_view<Source, F> const&>(v));
+}
+
+template <std::size_t n, typename Source, typename F>
+constexpr auto get(transform_view<Source, F>&& v) {
+    return get<n>(static_cast<transform_view<Source, F> const&>(v));
+}
+
+#endif
@@ -0,0 +1,75 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "type_list.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+template <typename T>
+struct type_ { using type = T; };
+
+struct add_pointer_class {
+    template <typename T>
+    struct apply { using type = T*; };
+};
+
+int main() {
+    // type_at
+    {
+        using Indexer = indexer<std::index_sequence<0, 1, 2>, int, char, float>;
+        static_assert(std::is_same<type_at<0, Indexer>, int>::value, "");
+        static_assert(std::is_same<type_at<2, Indexer>, float>::value, "");
+    }
+
+    // unpack_list_t
+    {
+        static_assert(std::is_same<
+            unpack_list_t<std::tuple, type_list<int, char>>,
+            std::tuple<int, char>
+        >::value, "");
+    }
+
+    // transform_t, transform_template_t and transform_class_t
+    {
+        static_assert(std::is_same<
+            transform_t<std::add_pointer, type_list<int, char const, void>>,
+            type_list<int*, char const*, void*>
+        >::value, "");
+
+        static_assert(std::is_same<
+            transform_t<std::add_pointer, type_list<>>,
+            type_list<>
+        >::value, "");
+
+        static_assert(std::is_same<
+            transform_template_t<std::vector, type_list<int, char>>,
+            type_list<std::vector<int>, std::vector<char>>
+        >::value, "");
+
+        static_assert(std::is_same<
+            transform_class_t<add_pointer_class, type_list<int, char>>,
+            type_list<int*, char*>
+        >::value, "");
+    }
+
+    // metafunction_all, template_all and metafunction_class_all
+    {
+        constexpr auto pointers = metafunction_all<std::add_pointer>(type_<int>{}, type_<char>{});
+        static_assert(std::is_same<
+            std::decay_t<decltype(pointers)>, type_list<int*, char*>
+        >::value, "");
+
+        constexpr auto tuple = template_all<std::tuple>(type_<int>{}, type_<char>{});
+        static_assert(std::is_same<
+            std::decay_t<decltype(tuple)>, type_list<std::tuple<int>, std::tuple<char>>
+        >::value, "");
+
+        constexpr auto cls = metafunction_class_all<add_pointer_class>(type_<int>{});
+        static_assert(std::is_same<
+            std::decay_t<decltype(cls)>, type_list<int*>
+        >::value, "");
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef TYPE_LIST_HPP
+#define TYPE_LIST_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// type_list and type_at
+//////////////////////////////////////////////////////////////////////////////
+template <typename ...T>
+struct type_list { };
+
+template <template <typename ...> class F, typename List>
+struct unpack_list;
+
+template <template <typename ...> class F, typename ...T>
+struct unpack_list<F, type_list<T...>> { using type = F<T...>; };
+
+// `unpack_list_t<std::tuple, type_list<int, char>>` is `std::tuple<int, char>`.
+template <template <typename ...> class F, typename List>
+using unpack_list_t = typename unpack_list<F, List>::type;
+
+template <std::size_t i, typename T>
+struct indexed { using type = T; };
+
+template <typename Indices, typename ...T>
+struct indexer;
+
+template <std::size_t ...i, typename ...T>
+struct indexer<std::index_sequence<i...>, T...> : indexed<i, T>... { };
+
+template <std::size_t i, typename T>
+indexed<i, T> select_indexed(indexed<i, T> const*);
+
+// Returns the `i`th type of a pack in a single overload resolution, by
+// deducing it from the corresponding base class of `indexer`. Hence, looking
+// up all the types of a pack does not require O(n^2) instantiations.
+template <std::size_t i, typename Indexer>
+using type_at = typename decltype(select_indexed<i>(std::declval<Indexer const*>()))::type;
+
+template <typename T, std::size_t i>
+constexpr std::size_t index_of_impl(indexed<i, T> const*) { return i; }
+
+// `index_of<U, Indexer>` is the index of `U` in the indexed types, found
+// with the same kind of overload resolution. `U` must appear only once.
+template <typename U, typename Indexer>
+using index_of = std::integral_constant<std::size_t,
+    index_of_impl<U>(static_cast<Indexer const*>(nullptr))
+>;
+
+//////////////////////////////////////////////////////////////////////////////
+// Batched metafunction application
+//////////////////////////////////////////////////////////////////////////////
+// These apply a metafunction to a whole list in a single pack expansion,
+// instead of wrapping each type, calling a function object on it and
+// unwrapping the result.
+template <template <typename ...> class F, typename List>
+struct transform_list;
+
+template <template <typename ...> class F, typename ...T>
+struct transform_list<F, type_list<T...>> {
+    using type = type_list<typename F<T>::type...>;
+};
+
+// `transform_t<std::add_pointer, type_list<int, char>>` is
+// `type_list<int*, char*>`.
+template <template <typename ...> class F, typename List>
+using transform_t = typename transform_list<F, List>::type;
+
+template <template <typename ...> class F, typename List>
+struct transform_template_list;
+
+template <template <typename ...> class F, typename ...T>
+struct transform_template_list<F, type_list<T...>> {
+    using type = type_list<F<T>...>;
+};
+
+// `transform_template_t<std::vector, type_list<int, char>>` is
+// `type_list<std::vector<int>, std::vector<char>>`.
+template <template <typename ...> class F, typename List>
+using transform_template_t = typename transform_template_list<F, List>::type;
+
+template <typename F>
+struct quote_class {
+    template <typename ...T>
+    using apply = typename F::template apply<T...>;
+};
+
+// Same as `transform_t`, but with a metafunction class, i.e. a type with a
+// nested `apply` metafunction, like `boost::mpl::quote1<std::add_pointer>`.
+template <typename F, typename List>
+using transform_class_t = transform_t<quote_class<F>::template apply, List>;
+
+// Value-level counterparts of the above. They accept any objects with a
+// nested `::type`, like Hana's `type<T>`, so they can be used with `unpack`
+// on a tuple of types:
+//
+//  unpack(tuple(type<int>, type<char>), metafunction_all<std::add_pointer>)
+//
+// returns a `type_list<int*, char*>`, with a single call. `to_types` in
+// type_list_hana.hpp converts it back to `tuple(type<int*>, type<char*>)`.
+template <template <typename ...> class F>
+struct metafunction_all_t {
+    template <typename ...Types>
+    constexpr type_list<typename F<typename Types::type>::type...>
+    operator()(Types const& ...) const
+    { return {}; }
+};
+
+template <template <typename ...> class F>
+constexpr metafunction_all_t<F> metafunction_all{};
+
+template <template <typename ...> class F>
+struct template_all_t {
+    template <typename ...Types>
+    constexpr type_list<F<typename Types::type>...>
+    operator()(Types const& ...) const
+    { return {}; }
+};
+
+template <template <typename ...> class F>
+constexpr template_all_t<F> template_all{};
+
+template <typename F>
+constexpr metafunction_all_t<quote_class<F>::template apply> metafunction_class_all{};
+
+#endif
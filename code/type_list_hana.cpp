@@ -0,0 +1,34 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "type_list_hana.hpp"
+
+#include <boost/hana/detail/assert.hpp>
+#include <boost/hana/functor.hpp>
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/type.hpp>
+
+#include <type_traits>
+#include <vector>
+using namespace boost::hana;
+
+
+int main() {
+    BOOST_HANA_CONSTANT_ASSERT(to_types(type_list<>{}) == tuple());
+    BOOST_HANA_CONSTANT_ASSERT(
+        to_types(type_list<int, char>{}) == tuple(type<int>, type<char>)
+    );
+
+    // The batched metafunctions give the same result as `fmap`.
+    BOOST_HANA_CONSTANT_ASSERT(
+        to_types(unpack(tuple(type<int>, type<char>), metafunction_all<std::add_pointer>))
+        ==
+        fmap(tuple(type<int>, type<char>), metafunction<std::add_pointer>)
+    );
+
+    BOOST_HANA_CONSTANT_ASSERT(
+        to_types(unpack(tuple(type<int>), template_all<std::vector>))
+        ==
+        tuple(type<std::vector<int>>)
+    );
+}
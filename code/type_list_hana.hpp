@@ -0,0 +1,30 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef TYPE_LIST_HANA_HPP
+#define TYPE_LIST_HANA_HPP
+
+#include "type_list.hpp"
+
+#include <boost/hana/tuple.hpp>
+#include <boost/hana/type.hpp>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// Conversion to Hana's types
+//////////////////////////////////////////////////////////////////////////////
+// type_list.hpp does not depend on Hana, so the batched metafunctions return
+// a `type_list`. This brings their result back to Hana's representation of
+// types, so that
+//
+//  to_types(unpack(tuple(type<int>, type<char>), metafunction_all<std::add_pointer>))
+//
+// is `tuple(type<int*>, type<char*>)`, like the result of `fmap` with
+// `metafunction<std::add_pointer>`. The conversion is also a single pack
+// expansion.
+template <typename ...T>
+constexpr auto to_types(type_list<T...>) {
+    return boost::hana::tuple(boost::hana::type<T>...);
+}
+
+#endif
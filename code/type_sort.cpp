@@ -0,0 +1,70 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "type_sort.hpp"
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+
+template <int i>
+struct storage { char s[i]; };
+
+template <typename T>
+using size_of = std::integral_constant<std::size_t, sizeof(T)>;
+
+int main() {
+    // sort_by_key
+    {
+        static_assert(std::is_same<
+            sort_by_key_t<std::alignment_of, std::greater<>>,
+            type_list<>
+        >::value, "");
+
+        static_assert(std::is_same<
+            sort_by_key_t<std::alignment_of, std::greater<>, int>,
+            type_list<int>
+        >::value, "");
+
+        static_assert(std::is_same<
+            sort_by_key_t<std::alignment_of, std::greater<>, int, char, long double>,
+            type_list<long double, int, char>
+        >::value, "");
+
+        static_assert(std::is_same<
+            sort_by_key_t<size_of, std::less<>,
+                storage<3>, storage<1>, storage<2>, storage<5>, storage<4>
+            >,
+            type_list<storage<1>, storage<2>, storage<3>, storage<4>, storage<5>>
+        >::value, "");
+
+        // The sort is stable.
+        static_assert(std::is_same<
+            sort_by_key_t<size_of, std::less<>,
+                int, char, unsigned, signed char, float, unsigned char
+            >,
+            type_list<char, signed char, unsigned char, int, unsigned, float>
+        >::value, "");
+
+        static_assert(std::is_same<
+            unpack_list_t<std::tuple,
+                sort_by_key_t<std::alignment_of, std::greater<>, int, char, long double>
+            >,
+            std::tuple<long double, int, char>
+        >::value, "");
+    }
+
+    // minimum_by_key
+    {
+        static_assert(std::is_same<
+            minimum_by_key_t<size_of, std::less<>, storage<3>, storage<1>, storage<2>>,
+            storage<1>
+        >::value, "");
+
+        static_assert(std::is_same<
+            minimum_by_key_t<size_of, std::less<>, int, char, signed char>,
+            char
+        >::value, "");
+    }
+}
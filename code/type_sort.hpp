@@ -0,0 +1,113 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef TYPE_SORT_HPP
+#define TYPE_SORT_HPP
+
+#include "type_list.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// sort_by_key and minimum_by_key
+//////////////////////////////////////////////////////////////////////////////
+// Sorting is done by computing the final position of each type in a constexpr
+// function, and then by looking up the type to put at each position. Unlike
+// a comparison sort written with templates, this does not instantiate
+// anything for each comparison; the only instantiations are `Key<T>` for
+// each type and one `indexer` for the whole list.
+template <std::size_t n>
+struct index_array { std::size_t values[n == 0 ? 1 : n]; };
+
+// Returns `order` such that `order[p]` is the index of the key that goes at
+// position `p` once the keys are stably sorted with `less`. This is a bottom
+// up merge sort, because a constexpr function performing O(n^2) comparisons
+// (like counting the rank of each key) is already too slow with a few hundred
+// keys.
+template <typename K, std::size_t n, typename Less>
+constexpr index_array<n> sorted_order(K const (&keys)[n], Less less) {
+    index_array<n> order{}, merged{};
+    for (std::size_t i = 0; i < n; ++i)
+        order.values[i] = i;
+
+    for (std::size_t width = 1; width < n; width *= 2) {
+        for (std::size_t lo = 0; lo < n; lo += 2 * width) {
+            std::size_t mid = lo + width < n ? lo + width : n;
+            std::size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            std::size_t i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (less(keys[order.values[j]], keys[order.values[i]]))
+                    merged.values[k++] = order.values[j++];
+                else
+                    merged.values[k++] = order.values[i++];
+            }
+            while (i < mid)
+                merged.values[k++] = order.values[i++];
+            while (j < hi)
+                merged.values[k++] = order.values[j++];
+        }
+        order = merged;
+    }
+    return order;
+}
+
+template <typename K, std::size_t n, typename Less>
+constexpr std::size_t minimum_index(K const (&keys)[n], Less less) {
+    std::size_t min = 0;
+    for (std::size_t i = 1; i < n; ++i)
+        if (less(keys[i], keys[min]))
+            min = i;
+    return min;
+}
+
+// The keys are all converted to the type of the first one, since
+// `std::common_type` would require O(n) recursive instantiations.
+template <template <typename> class Key, typename Indexer>
+using key_type = std::remove_cv_t<decltype(Key<type_at<0, Indexer>>::value)>;
+
+template <template <typename> class Key, typename Less, typename ...T>
+struct sort_by_key {
+    using Indexer = indexer<std::index_sequence_for<T...>, T...>;
+    using K = key_type<Key, Indexer>;
+    static constexpr K keys[] = {Key<T>::value...};
+    static constexpr index_array<sizeof...(T)> order = sorted_order(keys, Less{});
+
+    template <std::size_t ...p>
+    static type_list<type_at<order.values[p], Indexer>...>
+    sorted(std::index_sequence<p...>);
+
+    using type = decltype(sorted(std::index_sequence_for<T...>{}));
+};
+
+template <template <typename> class Key, typename Less, typename ...T>
+constexpr typename sort_by_key<Key, Less, T...>::K sort_by_key<Key, Less, T...>::keys[];
+
+template <template <typename> class Key, typename Less, typename ...T>
+constexpr index_array<sizeof...(T)> sort_by_key<Key, Less, T...>::order;
+
+template <template <typename> class Key, typename Less>
+struct sort_by_key<Key, Less> { using type = type_list<>; };
+
+// `sort_by_key_t<std::alignment_of, std::greater<>, T...>` is a `type_list`
+// of the `T`s sorted by decreasing alignment. The sort is stable.
+template <template <typename> class Key, typename Less, typename ...T>
+using sort_by_key_t = typename sort_by_key<Key, Less, T...>::type;
+
+template <template <typename> class Key, typename Less, typename ...T>
+struct minimum_by_key {
+    using Indexer = indexer<std::index_sequence_for<T...>, T...>;
+    using K = key_type<Key, Indexer>;
+    static constexpr K keys[] = {Key<T>::value...};
+
+    using type = type_at<minimum_index(keys, Less{}), Indexer>;
+};
+
+// `minimum_by_key_t<Key, Less, T...>` is the first of the `T`s whose key is
+// the smallest according to `Less`.
+template <template <typename> class Key, typename Less, typename ...T>
+using minimum_by_key_t = typename minimum_by_key<Key, Less, T...>::type;
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef USES_ALLOCATOR_HPP
+#define USES_ALLOCATOR_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// the proposed std::make_obj_using_allocator function
+//////////////////////////////////////////////////////////////////////////////
+// Creates a `T` from `args...` using uses-allocator construction, i.e. the
+// allocator is passed to the constructor of `T` whenever `T` uses it, either
+// after `std::allocator_arg` or as the last argument. This is how the
+// standard containers construct their elements with a scoped allocator, and
+// how the tuple backends pass an allocator down to their elements.
+template <typename T, typename Alloc, typename ...Args>
+using uses_allocator_convention = std::integral_constant<int,
+    !std::uses_allocator<T, Alloc>::value ? 0 :
+    std::is_constructible<T, std::allocator_arg_t, Alloc const&, Args...>::value ? 1 : 2
+>;
+
+template <typename T, typename Alloc, typename ...Args>
+T make_using_allocator_impl(std::integral_constant<int, 0>, Alloc const&, Args&& ...args)
+{ return T(std::forward<Args>(args)...); }
+
+template <typename T, typename Alloc, typename ...Args>
+T make_using_allocator_impl(std::integral_constant<int, 1>, Alloc const& a, Args&& ...args)
+{ return T(std::allocator_arg, a, std::forward<Args>(args)...); }
+
+template <typename T, typename Alloc, typename ...Args>
+T make_using_allocator_impl(std::integral_constant<int, 2>, Alloc const& a, Args&& ...args)
+{ return T(std::forward<Args>(args)..., a); }
+
+template <typename T, typename Alloc, typename ...Args>
+T make_using_allocator(Alloc const& a, Args&& ...args) {
+    return make_using_allocator_impl<T>(uses_allocator_convention<T, Alloc, Args...>{},
+                                        a, std::forward<Args>(args)...);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// constraints of the tuple constructors
+//////////////////////////////////////////////////////////////////////////////
+// Used by the tuple backends so that their element-wise constructor is not
+// selected instead of the copy constructor or of the allocator-extended ones.
+template <typename Tuple, typename ...U>
+struct is_same_tuple : std::false_type { };
+
+template <typename Tuple, typename U>
+struct is_same_tuple<Tuple, U> : std::is_same<std::decay_t<U>, Tuple> { };
+
+template <typename ...U>
+struct starts_with_allocator_arg : std::false_type { };
+
+template <typename U, typename ...Us>
+struct starts_with_allocator_arg<U, Us...>
+    : std::is_same<std::decay_t<U>, std::allocator_arg_t>
+{ };
+
+#endif
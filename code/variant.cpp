@@ -0,0 +1,126 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "variant.hpp"
+#include "lambda_tuple.hpp"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+
+struct counter {
+    static int alive;
+    counter() { ++alive; }
+    counter(counter const&) { ++alive; }
+    counter(counter&&) noexcept { ++alive; }
+    ~counter() { --alive; }
+};
+int counter::alive = 0;
+
+struct name_of {
+    std::string operator()(int) const { return "int"; }
+    std::string operator()(char) const { return "char"; }
+    std::string operator()(std::string const&) const { return "string"; }
+};
+
+struct is_rvalue {
+    template <typename X>
+    bool operator()(X&&) const { return !std::is_lvalue_reference<X>::value; }
+};
+
+struct combine {
+    template <typename X, typename Y>
+    int operator()(X const&, Y const&) const { return 0; }
+    int operator()(int x, int y) const { return x + y; }
+    int operator()(int x, char) const { return x; }
+    int operator()(std::string const& s, char c) const { return static_cast<int>(s.size()) + c; }
+};
+
+int main() {
+    // construction and access
+    {
+        variant<int, char, std::string> v;
+        assert(v.index() == 0);
+        assert(get<0>(v) == 0);
+
+        variant<int, char, std::string> c{'x'};
+        assert(c.index() == 1);
+        assert(holds_alternative<char>(c));
+        assert(get<char>(c) == 'x');
+
+        variant<int, char, std::string> s{std::string{"abc"}};
+        assert(get<std::string>(s) == "abc");
+
+        bool thrown = false;
+        try { get<int>(s); } catch (bad_variant_access const&) { thrown = true; }
+        assert(thrown);
+
+        static_assert(std::is_same<decltype(get<2>(s)), std::string&>::value, "");
+        static_assert(std::is_same<decltype(get<2>(std::move(s))), std::string&&>::value, "");
+    }
+
+    // variants can be used alongside the tuple backends
+    {
+        auto t = make_tuple(variant<int, char>{'x'}, 1);
+        assert(get<char>(get<0>(t)) == 'x');
+        assert(get<1>(get<0>(t)) == 'x');
+        assert(get<1>(t) == 1);
+    }
+
+    // copy, move and assignment destroy the active alternative exactly once
+    {
+        {
+            variant<int, counter> v{counter{}};
+            assert(counter::alive == 1);
+            variant<int, counter> w = v;
+            assert(counter::alive == 2);
+            variant<int, counter> x = std::move(w);
+            assert(counter::alive == 3);
+            v = 1;
+            assert(counter::alive == 2);
+            v = x;
+            assert(counter::alive == 3);
+            v = v;
+            assert(counter::alive == 3);
+        }
+        assert(counter::alive == 0);
+
+        variant<int, std::unique_ptr<int>> p{std::make_unique<int>(3)};
+        variant<int, std::unique_ptr<int>> q = std::move(p);
+        assert(*get<1>(q) == 3);
+    }
+
+    // visit
+    {
+        variant<int, char, std::string> v{'x'};
+        assert(visit(name_of{}, v) == "char");
+        v = std::string{"abc"};
+        assert(visit(name_of{}, v) == "string");
+        v = 3;
+        assert(visit(name_of{}, v) == "int");
+
+        // the visited alternative has the value category of the variant
+        variant<int, std::unique_ptr<int>> p{std::make_unique<int>(4)};
+        assert(!visit(is_rvalue{}, p));
+        assert(visit(is_rvalue{}, std::move(p)));
+    }
+
+    // visit of several variants
+    {
+        variant<int, std::string> a{std::string{"ab"}};
+        variant<int, char> b{'\x01'};
+        assert(visit(combine{}, a, b) == 3);
+
+        a = 4;
+        assert(visit(combine{}, a, b) == 4);
+        b = 5;
+        assert(visit(combine{}, a, b) == 9);
+
+        variant<int, char> c{'\x02'};
+        int args = visit([](auto const&, auto const&, auto const&) { return 3; }, a, b, c);
+        assert(args == 3);
+    }
+}
@@ -0,0 +1,271 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef VARIANT_HPP
+#define VARIANT_HPP
+
+#include "type_list.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// variant
+//////////////////////////////////////////////////////////////////////////////
+// A variant over distinct types `T...`. The active alternative is selected
+// with the same `indexer` used by `type_at`, so finding an alternative by
+// index or by type is a single overload resolution. Every operation which
+// depends on the active alternative (destruction, copy, move and `visit`) is
+// dispatched through a table of function pointers generated at compile-time,
+// so it costs one indirect call regardless of the number of alternatives.
+//
+// To keep assignment simple, the alternatives must be nothrow move
+// constructible, so a variant is never left without a value.
+struct bad_variant_access : std::exception {
+    char const* what() const noexcept override
+    { return "bad_variant_access"; }
+};
+
+template <typename ...N>
+constexpr std::size_t product(N ...n) {
+    std::size_t const ns[] = {1, static_cast<std::size_t>(n)...};
+    std::size_t result = 1;
+    for (std::size_t x : ns)
+        result *= x;
+    return result;
+}
+
+template <typename T>
+void destroy_as(void* p) { static_cast<T*>(p)->~T(); }
+
+template <typename T>
+void copy_as(void* dst, void const* src) { new (dst) T(*static_cast<T const*>(src)); }
+
+template <typename T>
+void move_as(void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); }
+
+template <typename ...T>
+class variant {
+    static_assert(sizeof...(T) > 0, "a variant must have at least one alternative");
+    static_assert(product(std::is_nothrow_move_constructible<T>::value...),
+        "the alternatives of a variant must be nothrow move constructible");
+
+    using Indexer = indexer<std::index_sequence_for<T...>, T...>;
+    std::aligned_union_t<0, T...> storage_;
+    std::size_t index_;
+
+    // When all the alternatives are trivial, the tables are not generated at
+    // all and the storage is handled as raw bytes.
+    using trivially_destructible = std::integral_constant<bool,
+        product(std::is_trivially_destructible<T>::value...)
+    >;
+    using trivially_copyable = std::integral_constant<bool,
+        product(std::is_trivially_copyable<T>::value...)
+    >;
+
+    void destroy() { destroy(trivially_destructible{}); }
+    void destroy(std::true_type) { }
+    void destroy(std::false_type) {
+        static constexpr void (*table[])(void*) = {&destroy_as<T>...};
+        table[index_](&storage_);
+    }
+
+    void copy_from(variant const& other) { copy_from(other, trivially_copyable{}); }
+    void copy_from(variant const& other, std::true_type) {
+        storage_ = other.storage_;
+        index_ = other.index_;
+    }
+    void copy_from(variant const& other, std::false_type) {
+        static constexpr void (*table[])(void*, void const*) = {&copy_as<T>...};
+        table[other.index_](&storage_, &other.storage_);
+        index_ = other.index_;
+    }
+
+    void move_from(variant& other) noexcept { move_from(other, trivially_copyable{}); }
+    void move_from(variant& other, std::true_type) noexcept { copy_from(other, std::true_type{}); }
+    void move_from(variant& other, std::false_type) noexcept {
+        static constexpr void (*table[])(void*, void*) = {&move_as<T>...};
+        table[other.index_](&storage_, &other.storage_);
+        index_ = other.index_;
+    }
+
+    template <typename U>
+    using is_variant = std::is_same<std::decay_t<U>, variant>;
+
+public:
+    template <std::size_t i>
+    using alternative = type_at<i, Indexer>;
+
+    variant() : index_(0) { new (&storage_) alternative<0>(); }
+
+    // The alternative is the one whose type is exactly `std::decay_t<U>`.
+    template <typename U, typename = std::enable_if_t<!is_variant<U>::value>>
+    variant(U&& u) : index_(index_of<std::decay_t<U>, Indexer>::value) {
+        new (&storage_) std::decay_t<U>(std::forward<U>(u));
+    }
+
+    variant(variant const& other) { copy_from(other); }
+    variant(variant&& other) noexcept { move_from(other); }
+
+    variant& operator=(variant const& other) {
+        if (this != &other) {
+            variant tmp(other);
+            destroy();
+            move_from(tmp);
+        }
+        return *this;
+    }
+
+    variant& operator=(variant&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            move_from(other);
+        }
+        return *this;
+    }
+
+    ~variant() { destroy(); }
+
+    std::size_t index() const { return index_; }
+
+    // Access to the alternative `i` without checking that it is active.
+    template <std::size_t i>
+    alternative<i>& unsafe_get() &
+    { return *reinterpret_cast<alternative<i>*>(&storage_); }
+
+    template <std::size_t i>
+    alternative<i> const& unsafe_get() const&
+    { return *reinterpret_cast<alternative<i> const*>(&storage_); }
+
+    template <std::size_t i>
+    alternative<i>&& unsafe_get() &&
+    { return std::move(*reinterpret_cast<alternative<i>*>(&storage_)); }
+
+    template <typename U>
+    using index_of_alternative = index_of<U, Indexer>;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// get and holds_alternative
+//////////////////////////////////////////////////////////////////////////////
+template <typename U, typename ...T>
+bool holds_alternative(variant<T...> const& v) {
+    return v.index() == variant<T...>::template index_of_alternative<U>::value;
+}
+
+// These are overloaded on the variant itself, so they don't collide with the
+// `get` functions of the tuple backends.
+template <std::size_t i, typename Variant>
+decltype(auto) checked_get(Variant&& v) {
+    if (v.index() != i)
+        throw bad_variant_access{};
+    return std::forward<Variant>(v).template unsafe_get<i>();
+}
+
+template <std::size_t i, typename ...T>
+decltype(auto) get(variant<T...>& v) { return checked_get<i>(v); }
+
+template <std::size_t i, typename ...T>
+decltype(auto) get(variant<T...> const& v) { return checked_get<i>(v); }
+
+template <std::size_t i, typename ...T>
+decltype(auto) get(variant<T...>&& v) { return checked_get<i>(std::move(v)); }
+
+template <typename U, typename ...T>
+decltype(auto) get(variant<T...>& v) {
+    return get<variant<T...>::template index_of_alternative<U>::value>(v);
+}
+
+template <typename U, typename ...T>
+decltype(auto) get(variant<T...> const& v) {
+    return get<variant<T...>::template index_of_alternative<U>::value>(v);
+}
+
+template <typename U, typename ...T>
+decltype(auto) get(variant<T...>&& v) {
+    return get<variant<T...>::template index_of_alternative<U>::value>(std::move(v));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// visit
+//////////////////////////////////////////////////////////////////////////////
+// Visiting several variants uses a single table indexed by the combination
+// of their active alternatives, like a multi-dimensional array.
+template <typename ...T>
+constexpr std::size_t variant_size(variant<T...> const*) { return sizeof...(T); }
+
+template <typename Variant>
+using variant_size_t = std::integral_constant<std::size_t,
+    variant_size(static_cast<std::decay_t<Variant> const*>(nullptr))
+>;
+
+// Returns the index of the active alternative of the `j`th variant, given the
+// flattened index `k` of the combination of active alternatives.
+template <std::size_t ...sizes>
+constexpr std::size_t alternative_index(std::size_t k, std::size_t j) {
+    constexpr std::size_t s[] = {sizes...};
+    std::size_t stride = 1;
+    for (std::size_t l = j + 1; l < sizeof...(sizes); ++l)
+        stride *= s[l];
+    return (k / stride) % s[j];
+}
+
+// The alternatives to visit are computed before instantiating the function
+// stored in the table, so there is a single function per combination.
+template <typename R, typename F, typename Alternatives, typename ...Variants>
+struct visit_dispatcher;
+
+template <typename R, typename F, std::size_t ...i, typename ...Variants>
+struct visit_dispatcher<R, F, std::index_sequence<i...>, Variants...> {
+    static R call(F&& f, Variants&& ...vs) {
+        return std::forward<F>(f)(
+            std::forward<Variants>(vs).template unsafe_get<i>()...
+        );
+    }
+};
+
+template <std::size_t k, typename R, typename F, typename Js, typename ...Variants>
+struct make_visit_dispatcher;
+
+template <std::size_t k, typename R, typename F, std::size_t ...j, typename ...Variants>
+struct make_visit_dispatcher<k, R, F, std::index_sequence<j...>, Variants...> {
+    using type = visit_dispatcher<R, F, std::index_sequence<
+        alternative_index<variant_size_t<Variants>::value...>(k, j)...
+    >, Variants...>;
+};
+
+template <typename R, typename F, typename ...Variants, std::size_t ...k>
+R visit_impl(std::index_sequence<k...>, F&& f, Variants&& ...vs) {
+    static constexpr R (*table[])(F&&, Variants&&...) = {
+        &make_visit_dispatcher<
+            k, R, F, std::index_sequence_for<Variants...>, Variants...
+        >::type::call...
+    };
+
+    std::size_t const indices[] = {vs.index()...};
+    constexpr std::size_t sizes[] = {variant_size_t<Variants>::value...};
+    std::size_t flat = 0;
+    for (std::size_t j = 0; j < sizeof...(Variants); ++j)
+        flat = flat * sizes[j] + indices[j];
+
+    return table[flat](std::forward<F>(f), std::forward<Variants>(vs)...);
+}
+
+template <typename Variant>
+using first_alternative_t = decltype(std::declval<Variant>().template unsafe_get<0>());
+
+// Calls `f` with the active alternatives of the given variants. `f` must
+// return the same type for all the combinations of alternatives.
+template <typename F, typename ...Variants>
+decltype(auto) visit(F&& f, Variants&& ...vs) {
+    using R = decltype(std::forward<F>(f)(std::declval<first_alternative_t<Variants>>()...));
+    constexpr std::size_t combinations = product(variant_size_t<Variants>::value...);
+    return visit_impl<R>(std::make_index_sequence<combinations>{},
+                         std::forward<F>(f), std::forward<Variants>(vs)...);
+}
+
+#endif
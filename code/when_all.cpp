@@ -0,0 +1,96 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#include "when_all.hpp"
+
+#include <cassert>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+
+int main() {
+    // eventual
+    {
+        eventual<int> x;
+        int seen = 0;
+        x.then([&](int v) { seen = v; });
+        assert(seen == 0);
+        x.set_value(3);
+        assert(seen == 3);
+        assert(x.get() == 3);
+
+        // continuations attached after the fact run right away
+        x.then([&](int v) { seen = v + 1; });
+        assert(seen == 4);
+    }
+
+    // when_all
+    {
+        eventual<int> a;
+        eventual<std::string> b;
+        eventual<double> c;
+        auto all = when_all(std::make_tuple(a, b, c));
+
+        bool done = false;
+        all.then([&](auto const&) { done = true; });
+
+        c.set_value(3.3);
+        a.set_value(1);
+        assert(!done);
+        b.set_value("foo");
+        assert(done);
+        assert(all.get() == std::make_tuple(1, std::string{"foo"}, 3.3));
+
+        auto none = when_all(std::tuple<>{});
+        assert(none.get() == std::tuple<>{});
+    }
+
+    // async_apply
+    {
+        eventual<int> a;
+        eventual<int> b;
+        int calls = 0;
+        auto sum = async_apply([&](int x, int y) { ++calls; return x + y; },
+                               std::make_tuple(a, b));
+        b.set_value(2);
+        a.set_value(1);
+        assert(sum.get() == 1 + 2);
+        assert(calls == 1);
+    }
+
+    // a void function gives an empty tuple once it has been called
+    {
+        eventual<int> a;
+        int seen = 0;
+        auto done = async_apply([&](int x) { seen = x; }, std::make_tuple(a));
+        static_assert(std::is_same<decltype(done), eventual<std::tuple<>>>::value, "");
+        a.set_value(3);
+        assert(done.get() == std::tuple<>{});
+        assert(seen == 3);
+    }
+
+    // the function is called as a non-const lvalue
+    {
+        eventual<int> a;
+        int total = 0;
+        auto f = [total](int x) mutable { total += x; return total; };
+        auto result = async_apply(f, std::make_tuple(a));
+        a.set_value(4);
+        assert(result.get() == 4);
+    }
+
+    // completion from other threads
+    {
+        eventual<int> a;
+        eventual<long> b;
+        auto product = async_apply([](int x, long y) { return x * y; },
+                                   std::make_tuple(a, b));
+        std::thread t1{[=] { a.set_value(6); }};
+        std::thread t2{[=] { b.set_value(7); }};
+        assert(product.get() == 42);
+        t1.join();
+        t2.join();
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright Louis Dionne 2014
+// Distributed under the Boost Software License, Version 1.0.
+
+#ifndef WHEN_ALL_HPP
+#define WHEN_ALL_HPP
+
+#include "std_tuple.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+//////////////////////////////////////////////////////////////////////////////
+// eventual
+//////////////////////////////////////////////////////////////////////////////
+// A value that becomes available at some point, like `std::future`, but to
+// which continuations can be attached with `then` instead of blocking until
+// the value is ready. Copies of an `eventual` share the same value.
+template <typename T>
+class eventual {
+    struct state {
+        std::mutex mutex;
+        std::condition_variable ready_cv;
+        std::unique_ptr<T> value;
+        std::vector<std::function<void(T const&)>> continuations;
+    };
+    std::shared_ptr<state> state_ = std::make_shared<state>();
+
+public:
+    // Makes the value available and runs the pending continuations on the
+    // calling thread. This must be called exactly once.
+    void set_value(T value) const {
+        std::vector<std::function<void(T const&)>> continuations;
+        {
+            std::lock_guard<std::mutex> lock{state_->mutex};
+            state_->value = std::make_unique<T>(std::move(value));
+            continuations.swap(state_->continuations);
+        }
+        state_->ready_cv.notify_all();
+        for (auto& k : continuations)
+            k(*state_->value);
+    }
+
+    // Calls `k` with the value once it is available. If it is already
+    // available, `k` is called right away on the calling thread. Otherwise,
+    // it is called by the thread calling `set_value`.
+    template <typename K>
+    void then(K k) const {
+        {
+            std::lock_guard<std::mutex> lock{state_->mutex};
+            if (!state_->value) {
+                state_->continuations.emplace_back(std::move(k));
+                return;
+            }
+        }
+        k(*state_->value);
+    }
+
+    // Blocks until the value is available and returns it.
+    T const& get() const {
+        std::unique_lock<std::mutex> lock{state_->mutex};
+        state_->ready_cv.wait(lock, [this] { return state_->value != nullptr; });
+        return *state_->value;
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// when_all and async_apply
+//////////////////////////////////////////////////////////////////////////////
+// Returns an `eventual` holding a tuple with the values of all the given
+// `eventual`s. A single continuation is attached to each element, and the
+// result is set by whichever thread completes the last element; no thread
+// ever blocks waiting for the elements one after the other.
+template <typename ...T>
+eventual<std::tuple<T...>> when_all(std::tuple<eventual<T>...> const& ts) {
+    struct shared {
+        std::atomic<std::size_t> remaining;
+        std::tuple<eventual<T>...> inputs;
+        eventual<std::tuple<T...>> result;
+    };
+    auto s = std::make_shared<shared>();
+    s->remaining = sizeof...(T);
+    s->inputs = ts;
+    auto result = s->result;
+
+    auto complete = [](shared& s) {
+        // All the values are available, so `get` does not block.
+        s.result.set_value(tuple_transform(s.inputs, [](auto const& e) {
+            return e.get();
+        }));
+    };
+
+    if (sizeof...(T) == 0)
+        complete(*s);
+
+    tuple_for_each(ts, [&](auto const& e) {
+        e.then([s, complete](auto const&) {
+            if (--s->remaining == 0)
+                complete(*s);
+        });
+    });
+    return result;
+}
+
+// `eventual<void>` could not hold its value, so a `void` function gives an
+// `eventual` holding an empty tuple instead, like `when_all` of no elements.
+template <typename F, typename ...T>
+std::tuple<> apply_values(std::true_type, F& f, std::tuple<T...> const& values) {
+    ::apply(f, values);
+    return {};
+}
+
+template <typename F, typename ...T>
+decltype(auto) apply_values(std::false_type, F& f, std::tuple<T...> const& values) {
+    return ::apply(f, values);
+}
+
+// Returns an `eventual` holding `f(x...)`, where `x...` are the values of the
+// given `eventual`s. `f` is moved into the continuation, and it is called
+// once as a non-const lvalue, by the thread completing the last element.
+template <typename F, typename ...T>
+auto async_apply(F&& f, std::tuple<eventual<T>...> const& ts) {
+    using Fn = std::decay_t<F>;
+    using Result = decltype(std::declval<Fn&>()(std::declval<T const&>()...));
+    using Void = std::is_void<Result>;
+    using R = std::conditional_t<Void::value, std::tuple<>, std::decay_t<Result>>;
+    eventual<R> result;
+    when_all(ts).then([f = Fn(std::forward<F>(f)), result](std::tuple<T...> const& values) mutable {
+        result.set_value(apply_values(Void{}, f, values));
+    });
+    return result;
+}
+
+#endif